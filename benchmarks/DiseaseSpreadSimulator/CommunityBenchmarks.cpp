@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "Enums.h"
+#include "Places/Community.h"
+#include "Places/PlaceBuilder.h"
+#include "Places/Places.h"
+#include "Person/Person.h"
+#include "Person/PersonPopulator.h"
+
+namespace Benchmarks
+{
+	static constexpr auto country{DiseaseSpreadSimulation::Country::USA};
+
+	void CommunityConstruction(benchmark::State& state)
+	{
+		const auto populationSize = static_cast<size_t>(state.range(0));
+		for ([[maybe_unused]] auto _ : state)
+		{
+			DiseaseSpreadSimulation::Community community{populationSize, country};
+			benchmark::DoNotOptimize(community.GetPopulation().data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(CommunityConstruction)->RangeMultiplier(10)->Range(1'000, 10'000'000)->Unit(benchmark::kMillisecond);
+
+	class CreatePopulation : public benchmark::Fixture
+	{
+	public:
+		using benchmark::Fixture::SetUp;
+		using benchmark::Fixture::TearDown;
+
+		void SetUp(const benchmark::State& state) override
+		{
+			populationSize = static_cast<size_t>(state.range(0));
+		}
+		void TearDown(const benchmark::State& /*state*/) override
+		{
+			places = {};
+		}
+
+	protected:
+		size_t populationSize{};
+		DiseaseSpreadSimulation::Places places{};
+		DiseaseSpreadSimulation::Community community{0U, country};
+	};
+	BENCHMARK_DEFINE_F(CreatePopulation, PersonPopulator)(benchmark::State& state)
+	{
+		for ([[maybe_unused]] auto _ : state)
+		{
+			// The persons are added to the places, so every run needs new ones
+			state.PauseTiming();
+			places = DiseaseSpreadSimulation::PlaceBuilder::CreatePlaces(populationSize, country);
+			state.ResumeTiming();
+
+			DiseaseSpreadSimulation::PersonPopulator populator(populationSize, DiseaseSpreadSimulation::PersonPopulator::GetCountryDistribution(country));
+			auto population = populator.CreatePopulation(country, places.homes, places.workplaces, places.schools, &community);
+			benchmark::DoNotOptimize(population.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK_REGISTER_F(CreatePopulation, PersonPopulator)->RangeMultiplier(10)->Range(1'000, 10'000'000)->Unit(benchmark::kMillisecond);
+} // namespace Benchmarks
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "Disease/Infection.h"
+#include "RandomNumbers.h"
+
+namespace Benchmarks
+{
+	// The contacts of one spreader with a batch of susceptible people, every person with its own stream
+	class WillInfect : public benchmark::Fixture
+	{
+	public:
+		using benchmark::Fixture::SetUp;
+		using benchmark::Fixture::TearDown;
+
+		void SetUp(const benchmark::State& state) override
+		{
+			const auto batchSize = static_cast<size_t>(state.range(0));
+			susceptibilities.assign(batchSize, susceptibility);
+			infected.assign(batchSize, 0U);
+			streamStates.clear();
+			for (size_t i = 0; i < batchSize; i++)
+			{
+				streamStates.push_back(Random::StreamSeed(1U, i));
+			}
+		}
+		void TearDown(const benchmark::State& /*state*/) override
+		{
+			susceptibilities.clear();
+			streamStates.clear();
+			infected.clear();
+		}
+
+	protected:
+		static constexpr double spreadFactor{0.5};
+		static constexpr double susceptibility{0.5};
+		std::vector<double> susceptibilities{};
+		std::vector<uint64_t> streamStates{};
+		std::vector<uint8_t> infected{};
+	};
+	BENCHMARK_DEFINE_F(WillInfect, Batch)(benchmark::State& state)
+	{
+		for ([[maybe_unused]] auto _ : state)
+		{
+			DiseaseSpreadSimulation::Infection::WillInfect(spreadFactor, susceptibilities, streamStates, infected);
+			benchmark::DoNotOptimize(infected.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK_REGISTER_F(WillInfect, Batch)->RangeMultiplier(8)->Range(8, 32'768);
+
+	// The same draws person by person as the contacts were drawn before the batches
+	BENCHMARK_DEFINE_F(WillInfect, OneByOne)(benchmark::State& state)
+	{
+		for ([[maybe_unused]] auto _ : state)
+		{
+			for (size_t i = 0; i < streamStates.size(); i++)
+			{
+				Random::Engine stream{streamStates[i]};
+				infected[i] = static_cast<uint8_t>(Random::UnitDouble(stream()) < spreadFactor * susceptibilities[i]);
+				streamStates[i] = stream.GetState();
+			}
+			benchmark::DoNotOptimize(infected.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK_REGISTER_F(WillInfect, OneByOne)->RangeMultiplier(8)->Range(8, 32'768);
+} // namespace Benchmarks
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "Enums.h"
+#include "Places/Places.h"
+#include "Person/Person.h"
+#include "Person/PersonBehavior.h"
+#include "RandomNumbers.h"
+
+namespace Benchmarks
+{
+	// A place with one person for every member of the population
+	class RemovePerson : public benchmark::Fixture
+	{
+	public:
+		using benchmark::Fixture::SetUp;
+		using benchmark::Fixture::TearDown;
+
+		void SetUp(const benchmark::State& state) override
+		{
+			const auto populationSize = static_cast<size_t>(state.range(0));
+			population.reserve(populationSize);
+			for (size_t i = 0; i < populationSize; i++)
+			{
+				population.emplace_back(DiseaseSpreadSimulation::Age_Group::UnderThirty, DiseaseSpreadSimulation::Sex::Female, DiseaseSpreadSimulation::PersonBehavior{}, nullptr);
+				place.AddPerson(&population.back());
+			}
+		}
+		void TearDown(const benchmark::State& /*state*/) override
+		{
+			population.clear();
+			place = DiseaseSpreadSimulation::Home{};
+		}
+
+	protected:
+		// Random persons in the same order for every size
+		DiseaseSpreadSimulation::Person* NextPerson()
+		{
+			Random::StreamGuard streamGuard(stream);
+			return &population[Random::RandomVectorIndex(population)];
+		}
+
+		std::vector<DiseaseSpreadSimulation::Person> population{};
+		DiseaseSpreadSimulation::Home place{};
+		Random::Engine stream{1U};
+	};
+	BENCHMARK_DEFINE_F(RemovePerson, ByPointer)(benchmark::State& state)
+	{
+		for ([[maybe_unused]] auto _ : state)
+		{
+			auto* person = NextPerson();
+			place.RemovePerson(person);
+			place.AddPerson(person);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_REGISTER_F(RemovePerson, ByPointer)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+
+	BENCHMARK_DEFINE_F(RemovePerson, ByID)(benchmark::State& state)
+	{
+		for ([[maybe_unused]] auto _ : state)
+		{
+			auto* person = NextPerson();
+			place.RemovePerson(person->GetID());
+			place.AddPerson(person);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_REGISTER_F(RemovePerson, ByID)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+} // namespace Benchmarks
@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Enums.h"
+#include "Disease/Disease.h"
+#include "Disease/DiseaseBuilder.h"
+#include "Places/Community.h"
+#include "Places/Places.h"
+#include "Person/Person.h"
+#include "Person/PersonBehavior.h"
+#include "Simulation/Simulation.h"
+
+namespace Benchmarks
+{
+	static constexpr auto country{DiseaseSpreadSimulation::Country::USA};
+	static constexpr uint64_t seed{42U};
+
+	// The setup of a large population takes long. Keep the simulation until another size is needed.
+	class SimulationHour : public benchmark::Fixture
+	{
+	public:
+		using benchmark::Fixture::SetUp;
+
+		void SetUp(const benchmark::State& state) override
+		{
+			const auto populationSize = static_cast<uint64_t>(state.range(0));
+			if (simulation == nullptr || simulatedPopulationSize != populationSize)
+			{
+				simulation.reset();
+				simulation = std::make_unique<DiseaseSpreadSimulation::Simulation>(populationSize, false, diseaseFilename, country, seed);
+				simulation->RunOneHour();
+				simulatedPopulationSize = populationSize;
+			}
+		}
+
+	protected:
+		static inline const std::string diseaseFilename{};
+		static inline std::unique_ptr<DiseaseSpreadSimulation::Simulation> simulation{};
+		static inline uint64_t simulatedPopulationSize{};
+	};
+	BENCHMARK_DEFINE_F(SimulationHour, Update)(benchmark::State& state)
+	{
+		// Every iteration simulates the next hour, so the iterations run through the whole day
+		for ([[maybe_unused]] auto _ : state)
+		{
+			simulation->RunOneHour();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK_REGISTER_F(SimulationHour, Update)->RangeMultiplier(10)->Range(1'000, 10'000'000)->Unit(benchmark::kMillisecond);
+
+	// One place with every tenth person infectious
+	class ContactsForPlace : public benchmark::Fixture
+	{
+	public:
+		using benchmark::Fixture::SetUp;
+		using benchmark::Fixture::TearDown;
+
+		void SetUp(const benchmark::State& state) override
+		{
+			const auto placeSize = static_cast<size_t>(state.range(0));
+			community.AddPlace(DiseaseSpreadSimulation::Home{});
+			auto* home = &community.GetHomes().back();
+
+			// Nobody travels or goes shopping while the disease develops
+			const DiseaseSpreadSimulation::PersonBehavior behavior{100U, 100U, 1.F, 0.F};
+			population.reserve(placeSize);
+			for (size_t i = 0; i < placeSize; i++)
+			{
+				population.emplace_back(DiseaseSpreadSimulation::Age_Group::UnderThirty, DiseaseSpreadSimulation::Sex::Female, behavior, &community, home);
+				if (i % infectiousEvery == 0U)
+				{
+					auto& person = population.back();
+					person.Contaminate(&disease);
+					while (!person.IsInfectious())
+					{
+						person.Update(1U, false, true);
+					}
+				}
+			}
+		}
+		void TearDown(const benchmark::State& /*state*/) override
+		{
+			population.clear();
+			community = DiseaseSpreadSimulation::Community{0U, country};
+		}
+
+	protected:
+		static constexpr size_t infectiousEvery{10U};
+		const DiseaseSpreadSimulation::Disease disease{DiseaseSpreadSimulation::DiseaseBuilder{}.CreateCorona()};
+		DiseaseSpreadSimulation::Community community{0U, country};
+		std::vector<DiseaseSpreadSimulation::Person> population{};
+		std::vector<DiseaseSpreadSimulation::Simulation::InfectionEvent> events{};
+	};
+	BENCHMARK_DEFINE_F(ContactsForPlace, CollectInfections)(benchmark::State& state)
+	{
+		const auto contactModel = static_cast<DiseaseSpreadSimulation::Contact_Model>(state.range(1));
+		auto& place = community.GetHomes().back();
+		for ([[maybe_unused]] auto _ : state)
+		{
+			DiseaseSpreadSimulation::Simulation::CollectInfections(place, contactModel, events);
+			benchmark::DoNotOptimize(events.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK_REGISTER_F(ContactsForPlace, CollectInfections)
+		->ArgsProduct({benchmark::CreateRange(2, 4096, 4),
+			{static_cast<int64_t>(DiseaseSpreadSimulation::Contact_Model::Pairwise), static_cast<int64_t>(DiseaseSpreadSimulation::Contact_Model::Aggregated)}})
+		->ArgNames({"people", "model"});
+} // namespace Benchmarks
@@ -1,6 +1,10 @@
 #include "CommandParser.h"
 #include <algorithm>
 #include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include "fmt/format.h"
+#include "RandomNumbers.h"
 
 DiseaseSpreadSimulation::CommandParser::CommandParser(int argc, char* argv[]) // NOLINT: We need the c-style array here
 {
@@ -8,6 +12,35 @@ DiseaseSpreadSimulation::CommandParser::CommandParser(int argc, char* argv[]) //
 	{
 		commands.emplace_back(argv[i]); // NOLINT: We need the pointer arithmetic here
 	}
+
+	// The ensemble only prints its summary and runs no single simulation to write or load.
+	// It creates a population for the seed of every replica, which a cache would make the same.
+	if (GetEnsemble())
+	{
+		for (const auto* option : {"--timeseries", "--save", "--load", "--region", "--population-cache"})
+		{
+			if (CommandExist(option))
+			{
+				throw std::invalid_argument(fmt::format("{} can't be used with --ensemble!", option));
+			}
+		}
+	}
+
+	// Checked before the processes are forked, so no run is lost at its end
+	if (GetRegionSize() > 0U && GetProcessCount() > 1U)
+	{
+#ifdef _WIN32
+		throw std::invalid_argument("--processes is not supported on Windows!");
+#else
+		for (const auto* option : {"--save", "--load"})
+		{
+			if (CommandExist(option))
+			{
+				throw std::invalid_argument(fmt::format("{} can't be used with a region split over several processes!", option));
+			}
+		}
+#endif
+	}
 }
 
 uint64_t DiseaseSpreadSimulation::CommandParser::GetPopulationSize() const
@@ -79,6 +112,96 @@ DiseaseSpreadSimulation::Country DiseaseSpreadSimulation::CommandParser::GetCoun
 	return Country::USA;
 }
 
+uint64_t DiseaseSpreadSimulation::CommandParser::GetSeed() const
+{
+	static constexpr auto command{"--seed"};
+	if (CommandExist(command))
+	{
+		return static_cast<uint64_t>(std::stoull(GetCommandOption(command)));
+	}
+
+	return Random::GetSeed();
+}
+
+DiseaseSpreadSimulation::Contact_Model DiseaseSpreadSimulation::CommandParser::GetContactModel() const
+{
+	static constexpr auto command{"--contacts"};
+	if (CommandExist(command) && GetCommandOption(command) == "pairwise")
+	{
+		return Contact_Model::Pairwise;
+	}
+
+	return Contact_Model::Aggregated;
+}
+
+bool DiseaseSpreadSimulation::CommandParser::GetEnsemble() const
+{
+	return CommandExist("--ensemble");
+}
+
+uint32_t DiseaseSpreadSimulation::CommandParser::GetThreadCount() const
+{
+	static constexpr auto command{"--threads"};
+	if (CommandExist(command))
+	{
+		return static_cast<uint32_t>(std::stoul(GetCommandOption(command)));
+	}
+
+	return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+const std::string& DiseaseSpreadSimulation::CommandParser::GetSaveFilename() const
+{
+	return GetCommandOption("--save");
+}
+
+const std::string& DiseaseSpreadSimulation::CommandParser::GetLoadFilename() const
+{
+	return GetCommandOption("--load");
+}
+
+const std::string& DiseaseSpreadSimulation::CommandParser::GetProfileFilename() const
+{
+	return GetCommandOption("--profile");
+}
+
+const std::string& DiseaseSpreadSimulation::CommandParser::GetTimeSeriesFilename() const
+{
+	return GetCommandOption("--timeseries");
+}
+
+const std::string& DiseaseSpreadSimulation::CommandParser::GetPopulationCacheDirectory() const
+{
+	return GetCommandOption("--population-cache");
+}
+
+uint32_t DiseaseSpreadSimulation::CommandParser::GetRegionSize() const
+{
+	static constexpr auto command{"--region"};
+	if (CommandExist(command))
+	{
+		return static_cast<uint32_t>(std::stoul(GetCommandOption(command)));
+	}
+
+	return 0U;
+}
+
+const std::string& DiseaseSpreadSimulation::CommandParser::GetMobilityFilename() const
+{
+	return GetCommandOption("--mobility");
+}
+
+uint32_t DiseaseSpreadSimulation::CommandParser::GetProcessCount() const
+{
+	static constexpr auto command{"--processes"};
+	if (CommandExist(command))
+	{
+		return std::max(static_cast<uint32_t>(std::stoul(GetCommandOption(command))), 1U);
+	}
+
+	return 1U;
+}
+
 bool DiseaseSpreadSimulation::CommandParser::CommandExist(std::string_view command) const
 {
 	return std::find(commands.begin(), commands.end(), command) != commands.end();
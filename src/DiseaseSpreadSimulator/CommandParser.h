@@ -9,6 +9,7 @@ namespace DiseaseSpreadSimulation
 	class CommandParser
 	{
 	public:
+		// Throws std::invalid_argument for options the ensemble would ignore and for options a split region can't use
 		CommandParser(int argc, char* argv[]);
 
 		// Will return default or command line argument provided population size
@@ -29,6 +30,34 @@ namespace DiseaseSpreadSimulation
 		// Will return default or command line argument provided country
 		[[nodiscard]] Country GetCountry() const;
 
+		// Will return a random seed or the command line argument provided seed
+		[[nodiscard]] uint64_t GetSeed() const;
+
+		// Will return the aggregated default or the command line argument provided contact model
+		[[nodiscard]] Contact_Model GetContactModel() const;
+
+		// Will return false default or true if command line argument is provided
+		[[nodiscard]] bool GetEnsemble() const;
+
+		// Will return the hardware concurrency or the command line argument provided thread count
+		[[nodiscard]] uint32_t GetThreadCount() const;
+
+		// Snapshot filenames can be empty
+		[[nodiscard]] const std::string& GetSaveFilename() const;
+		[[nodiscard]] const std::string& GetLoadFilename() const;
+		// Chrome trace filename can be empty
+		[[nodiscard]] const std::string& GetProfileFilename() const;
+		// Time series filename can be empty
+		[[nodiscard]] const std::string& GetTimeSeriesFilename() const;
+		// Population cache directory can be empty
+		[[nodiscard]] const std::string& GetPopulationCacheDirectory() const;
+		// Will return 0 or the command line argument provided number of linked communities
+		[[nodiscard]] uint32_t GetRegionSize() const;
+		// Mobility filename can be empty
+		[[nodiscard]] const std::string& GetMobilityFilename() const;
+		// Will return 1 or the command line argument provided number of processes for the region
+		[[nodiscard]] uint32_t GetProcessCount() const;
+
 		[[nodiscard]] bool CommandExist(std::string_view command) const;
 		[[nodiscard]] const std::string& GetCommandOption(std::string_view command) const;
 
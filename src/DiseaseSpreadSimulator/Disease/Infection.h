@@ -1,8 +1,11 @@
 #pragma once
 #include <cstdint>
+#include <span>
 #include <string>
+#include <vector>
 #include "Disease/Disease.h"
 #include "Enums.h"
+#include "Simulation/Snapshot.h"
 
 namespace DiseaseSpreadSimulation
 {
@@ -20,6 +23,12 @@ namespace DiseaseSpreadSimulation
 		void IncreaseSpreadCount();
 
 		static bool WillInfect(const Infection& exposed, float acceptanceFactor, const Community* community);
+		// Contacts of a spreader with a batch of susceptible people. Every person draws one number from its stream state
+		// and is infected when it is below the spread factor times its susceptibility. Draws the same numbers as WillInfect does one by one.
+		static void WillInfect(double spreadFactor, std::span<const double> susceptibilities, std::span<uint64_t> streamStates, std::span<uint8_t> infected);
+		// Chance to get infected by a contact with a spread factor of 1. The chance of a contact scales with the spread factor.
+		[[nodiscard]] static double Susceptibility(float acceptanceFactor, const Community* community);
+		[[nodiscard]] Seir_State GetSeirState() const;
 		[[nodiscard]] bool IsSusceptible() const;
 		[[nodiscard]] bool IsInfectious() const;
 		[[nodiscard]] bool IsFatal() const;
@@ -29,6 +38,12 @@ namespace DiseaseSpreadSimulation
 		[[nodiscard]] bool HasSymptoms() const;
 
 		[[nodiscard]] uint32_t GetSpreadCount() const;
+		[[nodiscard]] float GetSpreadFactor() const;
+
+		// The disease is stored as its index inside the diseases
+		static constexpr size_t minSnapshotSize{sizeof(Seir_State) + 3U * sizeof(bool) + 6U * sizeof(uint32_t) + sizeof(float)};
+		void Save(BinaryWriter& writer, const std::vector<Disease>& diseases) const;
+		void Load(BinaryReader& reader, const std::vector<Disease>& diseases);
 
 	private:
 		// Advance daysTillOutbreak, daysContagious, daysTillCured, daysToLive by a delta time
@@ -49,6 +64,7 @@ namespace DiseaseSpreadSimulation
 		bool isFatal{false};
 		float spreadFactor{0.F};
 
-		std::string noDisease{};
+		// Shared by every infection without a disease
+		static inline const std::string noDisease{};
 	};
 } // namespace DiseaseSpreadSimulation
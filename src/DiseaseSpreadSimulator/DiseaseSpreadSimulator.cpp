@@ -1,13 +1,105 @@
+#include <memory>
+#include <optional>
 #include "CommandParser.h"
 #include "Simulation/Simulation.h"
+#include "Simulation/Ensemble.h"
+#include "Simulation/ThreadPool.h"
+#include "Simulation/Mobility.h"
+#include "Simulation/ProcessGroup.h"
+#include "RandomNumbers.h"
+#include "Simulation/MeasureTime.h"
 
 int main(int argc, char* argv[])
 {
 	DiseaseSpreadSimulation::CommandParser commands{argc, argv};
 
-	DiseaseSpreadSimulation::Simulation simulation{commands.GetPopulationSize(), commands.GetWithPrint(), commands.GetDiseaseFilename(), commands.GetCountry()};
+	const auto seed = commands.GetSeed();
+	Random::SetSeed(seed);
 
-	simulation.CompareContainmentMeasures(commands.GetDaysToRun(), commands.GetNumberOfRuns());
+	if (commands.GetEnsemble())
+	{
+		DiseaseSpreadSimulation::ThreadPool pool{commands.GetThreadCount()};
+		const DiseaseSpreadSimulation::Ensemble ensemble{commands.GetPopulationSize(), commands.GetDiseaseFilename(), commands.GetCountry(), seed, commands.GetContactModel()};
+		ensemble.PrintSummary(commands.GetDaysToRun(), ensemble.Run(commands.GetDaysToRun(), commands.GetNumberOfRuns(), pool));
+	}
+	else
+	{
+		// Forked before anything else, so every process starts without threads. Every process runs a block of the region.
+		std::optional<DiseaseSpreadSimulation::ProcessGroup> processGroup{};
+		if (commands.GetRegionSize() > 0U && commands.GetProcessCount() > 1U)
+		{
+			processGroup.emplace(DiseaseSpreadSimulation::ProcessGroup::Fork(commands.GetProcessCount()));
+		}
+		const auto isRoot = !processGroup || processGroup->Rank() == 0U;
+
+		// Declared first to outlive the simulation
+		std::unique_ptr<DiseaseSpreadSimulation::TimeSeriesSink> timeSeries{};
+		std::unique_ptr<DiseaseSpreadSimulation::PopulationCache> populationCache{};
+		std::optional<DiseaseSpreadSimulation::MobilityMatrix> mobility{};
+		std::unique_ptr<DiseaseSpreadSimulation::ThreadPool> pool{};
+		DiseaseSpreadSimulation::Simulation simulation{commands.GetPopulationSize(), commands.GetWithPrint(), commands.GetDiseaseFilename(), commands.GetCountry(), seed, commands.GetContactModel()};
+		if (const auto& timeSeriesFilename = commands.GetTimeSeriesFilename(); !timeSeriesFilename.empty() && isRoot)
+		{
+			timeSeries = std::make_unique<DiseaseSpreadSimulation::TimeSeriesSink>(timeSeriesFilename, DiseaseSpreadSimulation::TimeSeriesSink::FormatFromFilename(timeSeriesFilename));
+			simulation.SetTimeSeriesSink(timeSeries.get());
+		}
+		if (const auto& cacheDirectory = commands.GetPopulationCacheDirectory(); !cacheDirectory.empty())
+		{
+			populationCache = std::make_unique<DiseaseSpreadSimulation::PopulationCache>(cacheDirectory);
+			simulation.SetPopulationCache(populationCache.get());
+		}
+		pool = std::make_unique<DiseaseSpreadSimulation::ThreadPool>(commands.GetThreadCount());
+		simulation.SetThreadPool(pool.get());
+		if (const auto regionSize = commands.GetRegionSize(); regionSize > 0U)
+		{
+			// Without a file the communities are linked to their neighbors
+			const auto& mobilityFilename = commands.GetMobilityFilename();
+			mobility = mobilityFilename.empty() ? DiseaseSpreadSimulation::MobilityMatrix::Ring(regionSize) : DiseaseSpreadSimulation::MobilityMatrix::FromFile(mobilityFilename, regionSize);
+			simulation.SetMobility(&*mobility, pool.get(), processGroup ? &*processGroup : nullptr);
+		}
+
+		// A loaded simulation continues its run for the days to run
+		const auto& loadFilename = commands.GetLoadFilename();
+		if (!loadFilename.empty())
+		{
+			simulation.LoadSnapshot(loadFilename);
+		}
+		if (mobility)
+		{
+			simulation.RunRegion(commands.GetDaysToRun());
+		}
+		else if (!loadFilename.empty())
+		{
+			simulation.RunForDays(commands.GetDaysToRun());
+		}
+		else
+		{
+			simulation.CompareContainmentMeasures(commands.GetDaysToRun(), commands.GetNumberOfRuns());
+		}
+
+		if (const auto& saveFilename = commands.GetSaveFilename(); !saveFilename.empty())
+		{
+			simulation.SaveSnapshot(saveFilename);
+		}
+		// Throws when the last records could not be written
+		if (timeSeries)
+		{
+			timeSeries->Close();
+		}
+		// Throws when another process of the group has failed
+		if (processGroup)
+		{
+			processGroup->Close();
+		}
+	}
+
+#ifdef ENABLE_PROFILING
+	Measure::Profiler::PrintSummary();
+	if (const auto& traceFilename = commands.GetProfileFilename(); !traceFilename.empty())
+	{
+		Measure::Profiler::WriteChromeTrace(traceFilename);
+	}
+#endif
 
 	return 0;
 }
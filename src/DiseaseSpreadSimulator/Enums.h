@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 
 namespace DiseaseSpreadSimulation
 {
@@ -20,7 +21,7 @@ namespace DiseaseSpreadSimulation
 	};
 
 	// Place related
-	enum class Place_Type
+	enum class Place_Type : uint8_t
 	{
 		Home,
 		Supply,
@@ -32,7 +33,7 @@ namespace DiseaseSpreadSimulation
 	};
 
 	// Person related
-	enum class Seir_State
+	enum class Seir_State : uint8_t
 	{
 		Susceptible,
 		Exposed,
@@ -40,7 +41,7 @@ namespace DiseaseSpreadSimulation
 		Recovered
 	};
 	// Age groups to differentiate between parts of the population from 0-9 years as first group up to > than 80 years as last group
-	enum class Age_Group
+	enum class Age_Group : uint8_t
 	{
 		UnderTen,
 		UnderTwenty,
@@ -52,11 +53,19 @@ namespace DiseaseSpreadSimulation
 		UnderEighty,
 		AboveEighty
 	};
-	enum class Sex
+	enum class Sex : uint8_t
 	{
 		Female,
 		Male
 	};
+	// Simulation related
+	// Pairwise draws once for every contact of an infectious with a susceptible person.
+	// Aggregated draws once for every susceptible person with the chance to escape all infectious persons of the place.
+	enum class Contact_Model
+	{
+		Pairwise,
+		Aggregated
+	};
 	enum class DiseaseContainmentMeasures
 	{
 		Nothing,
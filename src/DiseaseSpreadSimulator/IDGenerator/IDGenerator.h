@@ -10,9 +10,29 @@ namespace IDGenerator
 	{
 	public:
 		static uint32_t GetNextID()
+		{
+			return NextID()++;
+		}
+		// Reserve count ascending ids at once and return the first of them
+		static uint32_t GetNextIDs(uint32_t count)
+		{
+			return NextID().fetch_add(count);
+		}
+		// Make sure an id that was restored is never handed out again
+		static void SkipPast(uint32_t id) // NOLINT(*-identifier-length)
+		{
+			auto& nextID = NextID();
+			auto next = nextID.load();
+			while (next <= id && !nextID.compare_exchange_weak(next, id + 1U))
+			{
+			}
+		}
+
+	private:
+		static std::atomic<uint32_t>& NextID()
 		{
 			static std::atomic<uint32_t> id{0};
-			return id++;
+			return id;
 		}
 	};
 } // namespace IDGenerator
@@ -1,18 +1,34 @@
 #include "Person/Person.h"
+#include <algorithm>
+#include <stdexcept>
 #include "Disease/Disease.h"
 #include "IDGenerator/IDGenerator.h"
 #include "Places/Community.h"
 #include "Disease/DiseaseContainment.h"
 #include "RandomNumbers.h"
 
-DiseaseSpreadSimulation::Person::Person(Age_Group age, Sex sex, PersonBehavior behavior, Community* community, Home* home)
-	: id(IDGenerator::IDGenerator<Person>::GetNextID()),
+namespace
+{
+	template <typename T>
+	T* PlaceAs(DiseaseSpreadSimulation::Place* place, DiseaseSpreadSimulation::Place_Type type)
+	{
+		if (place != nullptr && place->GetType() != type)
+		{
+			throw std::runtime_error("Snapshot contains a place of the wrong type!");
+		}
+		return static_cast<T*>(place);
+	}
+} // namespace
+
+DiseaseSpreadSimulation::Person::Person(Age_Group age, Sex sex, PersonBehavior behavior, Community* community, Home* home, uint32_t personID)
+	: id(personID),
 	  m_age(age),
 	  m_sex(sex),
 	  m_behavior(behavior),
 	  m_community(community),
 	  m_home(home),
-	  whereabouts(home)
+	  whereabouts(home),
+	  m_randomStream(Random::Generator()())
 {
 	if (whereabouts != nullptr)
 	{
@@ -22,36 +38,53 @@ DiseaseSpreadSimulation::Person::Person(Age_Group age, Sex sex, PersonBehavior b
 
 void DiseaseSpreadSimulation::Person::Update(uint32_t currentTime, bool isWorkday, bool isNewDay)
 {
+	Random::StreamGuard streamGuard(m_randomStream);
 	CheckNextMove(currentTime, isWorkday, isNewDay);
 	infection.Update(*this, isNewDay);
+	SyncPopulationStore();
 }
 
 void DiseaseSpreadSimulation::Person::Contact(Person& other)
 {
 	if (IsInfectious() && other.IsSusceptible())
 	{
-		if (other.infection.WillInfect(infection, other.m_behavior.acceptanceFactor, other.m_community))
+		if (other.WillBeInfectedBy(*this))
 		{
 			SpreadDisease(*this, other);
 		}
 	}
 	else if (other.IsInfectious() && IsSusceptible())
 	{
-		if (infection.WillInfect(other.infection, m_behavior.acceptanceFactor, m_community))
+		if (WillBeInfectedBy(other))
 		{
 			SpreadDisease(other, *this);
 		}
 	}
 }
 
+bool DiseaseSpreadSimulation::Person::WillBeInfectedBy(const Person& spreader)
+{
+	// The draws are taken from the stream of the susceptible person
+	Random::StreamGuard streamGuard(m_randomStream);
+	return infection.WillInfect(spreader.infection, m_behavior.acceptanceFactor, m_community);
+}
+
 void DiseaseSpreadSimulation::Person::Contaminate(const Disease* disease)
 {
+	Random::StreamGuard streamGuard(m_randomStream);
 	infection.Contaminate(disease, m_age);
+	SyncPopulationStore();
+}
+
+void DiseaseSpreadSimulation::Person::IncreaseSpreadCount()
+{
+	infection.IncreaseSpreadCount();
 }
 
 void DiseaseSpreadSimulation::Person::Kill()
 {
 	alive = false;
+	SyncPopulationStore();
 }
 
 bool DiseaseSpreadSimulation::Person::IsSusceptible() const
@@ -119,11 +152,26 @@ uint32_t DiseaseSpreadSimulation::Person::GetSpreadCount() const
 	return infection.GetSpreadCount();
 }
 
+float DiseaseSpreadSimulation::Person::GetSpreadFactor() const
+{
+	return infection.GetSpreadFactor();
+}
+
+double DiseaseSpreadSimulation::Person::GetSusceptibility() const
+{
+	return Infection::Susceptibility(m_behavior.acceptanceFactor, m_community);
+}
+
 const DiseaseSpreadSimulation::Disease* DiseaseSpreadSimulation::Person::GetDisease() const
 {
 	return infection.GetDisease();
 }
 
+Random::Engine& DiseaseSpreadSimulation::Person::GetRandomStream()
+{
+	return m_randomStream;
+}
+
 DiseaseSpreadSimulation::Community* DiseaseSpreadSimulation::Person::GetCommunity()
 {
 	return m_community;
@@ -179,6 +227,16 @@ void DiseaseSpreadSimulation::Person::SetSchool(School* newSchool)
 	school = newSchool;
 }
 
+uint32_t DiseaseSpreadSimulation::Person::GetTravelDestination() const
+{
+	return travelDestination;
+}
+
+void DiseaseSpreadSimulation::Person::SetTravelDestination(uint32_t destination)
+{
+	travelDestination = destination;
+}
+
 void DiseaseSpreadSimulation::Person::SetCommunity(Community* newCommunity)
 {
 	m_community = newCommunity;
@@ -202,6 +260,76 @@ void DiseaseSpreadSimulation::Person::ChangeBehavior(PersonBehavior newBehavior)
 	m_behavior = newBehavior;
 }
 
+void DiseaseSpreadSimulation::Person::Save(BinaryWriter& writer, const std::vector<Disease>& diseases) const
+{
+	writer.Write(id);
+	writer.Write(m_age);
+	writer.Write(m_sex);
+	writer.Write(m_behavior.foodBuyInterval);
+	writer.Write(m_behavior.hardwareBuyInterval);
+	writer.Write(m_behavior.acceptanceFactor);
+	writer.Write(m_behavior.travelNeed);
+	writer.Write(alive);
+	writer.Write(isTraveling);
+	writer.Write(isQuarantined);
+	writer.Write(canWorkFromHome);
+	writer.Write(hasCriticalInfrastructureJob);
+
+	m_community->WritePlace(writer, m_home);
+	m_community->WritePlace(writer, whereabouts);
+	m_community->WritePlace(writer, workplace);
+	m_community->WritePlace(writer, school);
+
+	infection.Save(writer, diseases);
+	writer.Write(m_randomStream.GetState());
+
+	writer.Write(lastFoodBuy);
+	writer.Write(lastHardwareBuy);
+	writer.Write(travelDays);
+	writer.Write(travelDestination);
+	writer.Write(buyTime);
+	writer.Write(buyFinishTime);
+	writer.Write(isShoppingDay);
+	writer.Write(noTravelToday);
+}
+
+void DiseaseSpreadSimulation::Person::Load(BinaryReader& reader, const std::vector<Disease>& diseases)
+{
+	id = reader.Read<uint32_t>();
+	IDGenerator::IDGenerator<Person>::SkipPast(id);
+	m_age = reader.ReadEnum(Age_Group::AboveEighty);
+	m_sex = reader.ReadEnum(Sex::Male);
+	m_behavior.foodBuyInterval = reader.Read<uint32_t>();
+	m_behavior.hardwareBuyInterval = reader.Read<uint32_t>();
+	m_behavior.acceptanceFactor = reader.Read<float>();
+	m_behavior.travelNeed = reader.Read<float>();
+	alive = reader.ReadBool();
+	isTraveling = reader.ReadBool();
+	isQuarantined = reader.ReadBool();
+	canWorkFromHome = reader.ReadBool();
+	hasCriticalInfrastructureJob = reader.ReadBool();
+
+	// The places add us again when they are loaded
+	m_home = PlaceAs<Home>(m_community->ReadPlace(reader), Place_Type::Home);
+	whereabouts = m_community->ReadPlace(reader);
+	workplace = PlaceAs<Workplace>(m_community->ReadPlace(reader), Place_Type::Workplace);
+	school = PlaceAs<School>(m_community->ReadPlace(reader), Place_Type::School);
+	m_slotPlace = nullptr;
+	m_placeSlot = 0U;
+
+	infection.Load(reader, diseases);
+	m_randomStream = Random::Engine{reader.Read<uint64_t>()};
+
+	lastFoodBuy = reader.Read<uint32_t>();
+	lastHardwareBuy = reader.Read<uint32_t>();
+	travelDays = reader.Read<uint32_t>();
+	travelDestination = reader.Read<uint32_t>();
+	buyTime = reader.Read<uint32_t>();
+	buyFinishTime = reader.Read<uint32_t>();
+	isShoppingDay = reader.ReadBool();
+	noTravelToday = reader.ReadBool();
+}
+
 // TODO: Refactor this complex function. Silence warnings untill then
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 void DiseaseSpreadSimulation::Person::CheckNextMove(uint32_t currentTime, bool& isWorkday, bool isNewDay)
@@ -278,10 +406,11 @@ void DiseaseSpreadSimulation::Person::CheckNextMove(uint32_t currentTime, bool&
 		else if (!isShoppingDay)
 		{
 			// No traveling during a lockdown
-			if (WillTravel()
-				&& currentTime >= shopOpenTime
+			// Roll the travel chance last to only draw a random number when it matters
+			if (currentTime >= shopOpenTime
 				&& !containmentMeasures.IsLockdown()
-				&& !noTravelToday)
+				&& !noTravelToday
+				&& WillTravel())
 			{
 				StartTraveling();
 			}
@@ -393,6 +522,99 @@ void DiseaseSpreadSimulation::Person::CheckNextMove(uint32_t currentTime, bool&
 	}
 }
 
+uint32_t DiseaseSpreadSimulation::Person::NextUpdateTime(uint32_t currentTime, bool isWorkday) const
+{
+	// Mirrors the decisions of CheckNextMove and returns the first hour in which one of them can change anything
+	const auto nextHour = currentTime + 1U;
+	const auto notBefore = [nextHour](uint32_t time)
+	{
+		return std::min(std::max(nextHour, time), nextDay);
+	};
+
+	if (!alive)
+	{
+		// Wait in the morgue for ever or get there at the next hour
+		return (whereabouts != nullptr && whereabouts->GetType() == Place_Type::Morgue) ? nextDay : nextHour;
+	}
+	if (isQuarantined)
+	{
+		// A person has recovered only after the infection update at the start of a day
+		return infection.HasRecovered() ? notBefore(shopOpenTime) : nextDay;
+	}
+	// Try to get tested every hour while the test station is open. Until then the usual moves are made.
+	const auto testTime = infection.HasSymptoms() ? notBefore(shopOpenTime) : nextDay;
+	if (whereabouts == nullptr || m_community == nullptr)
+	{
+		return testTime;
+	}
+
+	const auto& containmentMeasures = m_community->ContainmentMeasures();
+	auto next = nextHour;
+	switch (whereabouts->GetType())
+	{
+	case Place_Type::Home:
+	{
+		const bool needFood = lastFoodBuy >= m_behavior.foodBuyInterval;
+		const bool needHardware = lastHardwareBuy >= m_behavior.hardwareBuyInterval
+								  && !containmentMeasures.ShopsAreClosed()
+								  && !containmentMeasures.IsLockdown();
+		if (needFood || needHardware)
+		{
+			next = notBefore(isShoppingDay ? std::max(buyTime, shopOpenTime) : shopOpenTime);
+			break;
+		}
+		if (isShoppingDay)
+		{
+			next = nextDay;
+			break;
+		}
+		if (!noTravelToday && !containmentMeasures.IsLockdown())
+		{
+			// The next update decides about travel. Before the shops open it only rules out travel for today.
+			next = nextHour;
+			break;
+		}
+
+		next = nextDay;
+		if (workplace != nullptr
+			&& isWorkday
+			&& nextHour <= workFinishTime
+			&& !(containmentMeasures.WorkingFromHome() && canWorkFromHome)
+			&& !(containmentMeasures.IsLockdown() && !hasCriticalInfrastructureJob))
+		{
+			next = std::min(next, notBefore(workStartTime));
+		}
+		if (school != nullptr
+			&& isWorkday
+			&& nextHour <= schoolFinishTime
+			&& !containmentMeasures.WorkingFromHome()
+			&& !containmentMeasures.IsLockdown())
+		{
+			next = std::min(next, notBefore(schoolStartTime));
+		}
+		break;
+	}
+	case Place_Type::Supply:
+	case Place_Type::HardwareStore:
+		next = notBefore(buyFinishTime);
+		break;
+	case Place_Type::Workplace:
+		next = notBefore(workFinishTime);
+		break;
+	case Place_Type::School:
+		next = notBefore(schoolFinishTime);
+		break;
+	case Place_Type::Morgue:
+	case Place_Type::Travel:
+		// Travelers only decide to return at the start of a day
+		next = nextDay;
+		break;
+	default:
+		break;
+	}
+	return std::min(next, testTime);
+}
+
 void DiseaseSpreadSimulation::Person::PrepareShopping()
 {
 	if (!isShoppingDay)
@@ -450,12 +672,16 @@ void DiseaseSpreadSimulation::Person::StartTraveling()
 {
 	whereabouts = m_community->TransferToTravelLocation(this);
 	isTraveling = true;
+	// Every trip chooses its destination again
+	travelDestination = noDestination;
 }
 
 void DiseaseSpreadSimulation::Person::SpreadDisease(Person& spreader, Person& other)
 {
+	Random::StreamGuard streamGuard(other.m_randomStream);
 	other.infection.Contaminate(spreader.infection.GetDisease(), other.m_age);
 	spreader.infection.IncreaseSpreadCount();
+	other.SyncPopulationStore();
 }
 
 void DiseaseSpreadSimulation::Person::StartQuarantine()
@@ -467,3 +693,20 @@ void DiseaseSpreadSimulation::Person::EndQuarantine()
 {
 	isQuarantined = false;
 }
+
+void DiseaseSpreadSimulation::Person::SyncPopulationStore()
+{
+	if (m_community == nullptr || m_storeRow == PopulationStore::noRow)
+	{
+		return;
+	}
+
+	// Copies of a person keep the row of the original. Only the person inside the population owns it.
+	auto& population = m_community->GetPopulation();
+	if (m_storeRow >= population.size() || &population[m_storeRow] != this)
+	{
+		return;
+	}
+
+	m_community->GetPopulationStore().Write(m_storeRow, *this);
+}
@@ -1,10 +1,14 @@
 #pragma once
 #include <cstdint>
+#include <limits>
 #include <string>
 #include "Enums.h"
+#include "IDGenerator/IDGenerator.h"
 #include "Disease/Infection.h"
 #include "Places/Places.h"
 #include "Person/PersonBehavior.h"
+#include "Person/PopulationStore.h"
+#include "RandomNumbers.h"
 
 namespace DiseaseSpreadSimulation
 {
@@ -15,9 +19,13 @@ namespace DiseaseSpreadSimulation
 	class Person
 	{
 	public:
-		Person(Age_Group age, Sex sex, PersonBehavior behavior, Community* community, Home* home = nullptr);
+		// Takes the next free id unless one was reserved for the person
+		Person(Age_Group age, Sex sex, PersonBehavior behavior, Community* community, Home* home = nullptr, uint32_t personID = IDGenerator::IDGenerator<Person>::GetNextID());
 
 		friend class DiseaseContainment;
+		friend class PopulationStore;
+		friend class Place;
+		friend class Community;
 
 		auto operator<=>(const Person& rhs) const
 		{
@@ -37,10 +45,20 @@ namespace DiseaseSpreadSimulation
 		}
 
 		void Update(uint32_t currentTime, bool isWorkday, bool isNewDay);
+		// Returns the next hour of the day at which an update can change anything for us.
+		// Returns nextDay when there is nothing to do before the start of the next day.
+		[[nodiscard]] uint32_t NextUpdateTime(uint32_t currentTime, bool isWorkday) const;
+		static constexpr uint32_t nextDay{24U};
 
 		// Will try to infect a susceptible person when the other is infectious
 		void Contact(Person& other);
+		// Decide if a contact with the infectious spreader infects us. Only draws from our own stream and changes nothing else.
+		[[nodiscard]] bool WillBeInfectedBy(const Person& spreader);
+		// Infect the other person with the disease of the spreader
+		static void SpreadDisease(Person& spreader, Person& other);
 		void Contaminate(const Disease* disease);
+		// Count an infection this person spread while only the record of the other person was at hand
+		void IncreaseSpreadCount();
 		void Kill();
 
 		[[nodiscard]] bool IsSusceptible() const;
@@ -57,7 +75,12 @@ namespace DiseaseSpreadSimulation
 		[[nodiscard]] Sex GetSex() const;
 		[[nodiscard]] const PersonBehavior& GetBehavior() const;
 		[[nodiscard]] uint32_t GetSpreadCount() const;
+		[[nodiscard]] float GetSpreadFactor() const;
+		// Chance that a contact with a spread factor of 1 infects us
+		[[nodiscard]] double GetSusceptibility() const;
 		[[nodiscard]] const Disease* GetDisease() const;
+		// Every random decision of this person is drawn from its own stream
+		Random::Engine& GetRandomStream();
 
 		Community* GetCommunity();
 		Place* GetWhereabouts();
@@ -75,6 +98,18 @@ namespace DiseaseSpreadSimulation
 
 		void ChangeBehavior(PersonBehavior newBehavior);
 
+		// Index of the community we visit on the current trip. Only linked communities send travelers to another community.
+		[[nodiscard]] uint32_t GetTravelDestination() const;
+		void SetTravelDestination(uint32_t destination);
+		static constexpr uint32_t noDestination{std::numeric_limits<uint32_t>::max()};
+
+		// The places are stored through our community, so we need one. Load needs the places of the community to exist already.
+		// A stored person takes at least its fixed values, its four places as type and index and its infection.
+		static constexpr size_t minSnapshotSize{9U * sizeof(uint32_t) + 2U * sizeof(float) + 2U * sizeof(uint8_t) + 7U * sizeof(bool) + sizeof(uint64_t) +
+			4U * (sizeof(Place_Type) + sizeof(uint32_t)) + Infection::minSnapshotSize};
+		void Save(BinaryWriter& writer, const std::vector<Disease>& diseases) const;
+		void Load(BinaryReader& reader, const std::vector<Disease>& diseases);
+
 	private:
 		void CheckNextMove(uint32_t currentTime, bool& isWorkday, bool isNewDay);
 		void PrepareShopping();
@@ -83,9 +118,10 @@ namespace DiseaseSpreadSimulation
 		[[nodiscard]] bool WillTravel() const;
 		void StartTraveling();
 
-		static void SpreadDisease(Person& spreader, Person& other);
 		void StartQuarantine();
 		void EndQuarantine();
+		// Write our current state into our row of the community population store
+		void SyncPopulationStore();
 
 	
 		uint32_t id;
@@ -106,11 +142,20 @@ namespace DiseaseSpreadSimulation
 		School* school{nullptr};
 
 		Infection infection;
+		// Independent random stream. Keeps the result independent of the thread that updates us.
+		Random::Engine m_randomStream;
+		// Row inside the population store of our community
+		uint32_t m_storeRow{PopulationStore::noRow};
+		// The place we were added to last and our index inside its people.
+		// Differs from whereabouts until a deferred transfer was applied.
+		Place* m_slotPlace{nullptr};
+		uint32_t m_placeSlot{0U};
 
 		// In days
 		uint32_t lastFoodBuy{0U};
 		uint32_t lastHardwareBuy{0U};
 		uint32_t travelDays{0U};
+		uint32_t travelDestination{noDestination};
 		// In hours
 		uint32_t buyTime{0U};
 		uint32_t buyFinishTime{0U};
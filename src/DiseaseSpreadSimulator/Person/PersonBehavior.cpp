@@ -1,6 +1,5 @@
 #include "Person/PersonBehavior.h"
 #include <array>
-#include <random>
 #include "RandomNumbers.h"
 
 // I can't see a beneficial fix for this
@@ -25,8 +24,11 @@ DiseaseSpreadSimulation::PersonBehavior::PersonBehavior()
 	static constexpr std::array<float, 5> travelIntervals{0.F, .0005F, .001F, .005F, .01F};
 	static constexpr std::array<float, 4> travelweights{45.F, 30.F, 20.F, 5.F};
 
-	std::piecewise_constant_distribution<float> acceptanceDistribution(acceptanceIntervals.begin(), acceptanceIntervals.end(), acceptanceWeights.begin());
-	acceptanceFactor = acceptanceDistribution(Random::generator);
-	std::piecewise_constant_distribution<float> travelDistribution(travelIntervals.begin(), travelIntervals.end(), travelweights.begin());
-	travelNeed = travelDistribution(Random::generator);
+	// Pick an interval by its weight and a uniform value inside it
+	static const Random::AliasTable acceptanceTable{acceptanceWeights};
+	const auto acceptanceIndex = acceptanceTable();
+	acceptanceFactor = Random::UniformFloatRange(acceptanceIntervals.at(acceptanceIndex), acceptanceIntervals.at(acceptanceIndex + 1U));
+	static const Random::AliasTable travelTable{travelweights};
+	const auto travelIndex = travelTable();
+	travelNeed = Random::UniformFloatRange(travelIntervals.at(travelIndex), travelIntervals.at(travelIndex + 1U));
 }
@@ -1,8 +1,12 @@
 #include "Person/PersonPopulator.h"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
 #include "Person/Person.h"
 #include "Person/PersonBehavior.h"
 #include "Places/Community.h"
 #include "Places/PlaceBuilder.h"
+#include "Simulation/ThreadPool.h"
 
 DiseaseSpreadSimulation::PersonPopulator::PersonPopulator(const size_t populationSize, std::vector<Statistics::HumanDistribution> humanDistribution)
 	: m_populationSize(populationSize),
@@ -20,7 +24,7 @@ DiseaseSpreadSimulation::PersonPopulator::PersonPopulator(const size_t populatio
 
 // TODO: Consider refactor to places class
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-std::vector<DiseaseSpreadSimulation::Person> DiseaseSpreadSimulation::PersonPopulator::CreatePopulation(Country country, std::vector<Home>& homes, std::vector<Workplace>& workplaces, std::vector<School>& schools, Community* community)
+std::vector<DiseaseSpreadSimulation::Person> DiseaseSpreadSimulation::PersonPopulator::CreatePopulation(Country country, std::vector<Home>& homes, std::vector<Workplace>& workplaces, std::vector<School>& schools, Community* community, ThreadPool* pool)
 {
 	std::vector<Person> population{};
 	// Return early if the population is 0
@@ -29,7 +33,13 @@ std::vector<DiseaseSpreadSimulation::Person> DiseaseSpreadSimulation::PersonPopu
 		return population;
 	}
 
-	population.reserve(m_populationSize);
+	// The age and sex of every person in order
+	std::vector<Statistics::HumanDistribution> demographics{};
+	demographics.reserve(m_populationSize);
+	while (!m_allAssigned)
+	{
+		demographics.push_back(NextHumanDistribution());
+	}
 
 	// This bool will ensure that a workplace is only assigned if there are workplaces
 	bool noWorkplace{workplaces.empty()};
@@ -43,37 +53,96 @@ std::vector<DiseaseSpreadSimulation::Person> DiseaseSpreadSimulation::PersonPopu
 			return &workplace;
 		});
 
-	auto workplacesBySize = PlaceBuilder::WorkplacesBySize(m_populationSize, country, std::move(sortedWorkplaces));
+	const auto workplacesBySize = PlaceBuilder::WorkplacesBySize(m_populationSize, country, std::move(sortedWorkplaces));
 
-	// Create the population
-	size_t schoolIndex{0};
-	auto averageSchoolSize = Statistics::AverageSchoolSize(country);
-	while (!m_allAssigned)
-	{
-		// Get a new person
-		auto person = GetNewPerson(community);
+	std::vector<Home*> sortedHomes{};
+	sortedHomes.reserve(homes.size());
+	std::transform(homes.begin(), homes.end(), std::back_inserter(sortedHomes), [](auto& home)
+		{
+			return &home;
+		});
+
+	const auto homesByMemberCount = HomesByMemberCount(m_populationSize, country, sortedHomes);
+	// Built once and shared by every chunk
+	const auto homeSizeTable = HomeSizeTable(country);
+	const Random::AliasTable workplaceSizeTable{Statistics::workplaceSizePercent};
+	const auto& containmentMeasures = community->ContainmentMeasures();
+
+	// Reserve the ids up front so that they follow the order of the population
+	const auto firstID = IDGenerator::IDGenerator<Person>::GetNextIDs(static_cast<uint32_t>(m_populationSize));
+	const auto chunkSeed = Random::Generator()();
 
-		// Assigne a workplace when the person is in working age and there are workplaces
-		if (!noWorkplace && person.GetAgeGroup() > Age_Group::UnderTwenty && person.GetAgeGroup() <= Age_Group::UnderSeventy)
+	std::vector<size_t> chunks((m_populationSize + chunkSize - 1U) / chunkSize);
+	std::iota(chunks.begin(), chunks.end(), size_t{0U});
+	std::vector<std::vector<Person>> chunkPopulations(chunks.size());
+	// Homes are only picked in parallel and assigned afterwards because the home keeps a pointer to the person
+	std::vector<Home*> assignedHomes(m_populationSize);
+
+	const auto createChunk = [&](size_t chunk)
+	{
+		Random::Engine stream{Random::StreamSeed(chunkSeed, chunk)};
+		Random::StreamGuard useStream{stream};
+		const auto begin = chunk * chunkSize;
+		const auto end = std::min(begin + chunkSize, m_populationSize);
+		auto& chunkPopulation = chunkPopulations.at(chunk);
+		chunkPopulation.reserve(end - begin);
+		for (auto index = begin; index < end; index++)
 		{
-			person.SetWorkplace(AssignWorkplace(workplacesBySize));
-			// Check if the person can work from home or has a critical infrastructure job
+			const auto& demographic = demographics.at(index);
+			auto& person = chunkPopulation.emplace_back(demographic.ageGroup, demographic.sex, PersonBehavior(), community, nullptr, firstID + static_cast<uint32_t>(index));
 
-			// 50% of working people are allowed to go to work when there is a working from home mandate.
-			// Reflecting jobs that are not capable of work from home
-			if (Random::Percent<float>() <= community->ContainmentMeasures().percentOfJobsNoWorkFromHome)
-			{
-				person.SetCanWorkFromHome();
-			}
-			// During a lockdown only 10% of people are allowed to go to work
-			// Reflecting jobs that are mandatory to supply people
-			if (Random::Percent<float>() <= community->ContainmentMeasures().percentOfJobsMandatoryToSupply)
+			// Assigne a workplace when the person is in working age and there are workplaces
+			if (!noWorkplace && person.GetAgeGroup() > Age_Group::UnderTwenty && person.GetAgeGroup() <= Age_Group::UnderSeventy)
 			{
-				person.SetHasCriticalInfrastructureJob();
+				person.SetWorkplace(AssignWorkplace(workplaceSizeTable, workplacesBySize));
+				// Check if the person can work from home or has a critical infrastructure job
+
+				// 50% of working people are allowed to go to work when there is a working from home mandate.
+				// Reflecting jobs that are not capable of work from home
+				if (Random::Percent<float>() <= containmentMeasures.percentOfJobsNoWorkFromHome)
+				{
+					person.SetCanWorkFromHome();
+				}
+				// During a lockdown only 10% of people are allowed to go to work
+				// Reflecting jobs that are mandatory to supply people
+				if (Random::Percent<float>() <= containmentMeasures.percentOfJobsMandatoryToSupply)
+				{
+					person.SetHasCriticalInfrastructureJob();
+				}
 			}
+			assignedHomes.at(index) = AssignHome(person.GetAgeGroup(), homeSizeTable, homesByMemberCount);
+		}
+	};
+	if (pool != nullptr)
+	{
+		for (const auto chunk : chunks)
+		{
+			pool->Submit([&createChunk, chunk]()
+				{
+					createChunk(chunk);
+				});
 		}
+		pool->Wait();
+	}
+	else
+	{
+		std::for_each(chunks.begin(), chunks.end(), createChunk);
+	}
+
+	population.reserve(m_populationSize);
+	for (auto& chunkPopulation : chunkPopulations)
+	{
+		std::move(chunkPopulation.begin(), chunkPopulation.end(), std::back_inserter(population));
+	}
+
+	// Schools are filled one after another, so they are assigned in order of the population
+	size_t schoolIndex{0};
+	auto averageSchoolSize = Statistics::AverageSchoolSize(country);
+	for (size_t index = 0; index < population.size(); index++)
+	{
+		auto& person = population.at(index);
 		// Assign a school for every person under twenty
-		else if (person.GetAgeGroup() <= Age_Group::UnderTwenty)
+		if (person.GetAgeGroup() <= Age_Group::UnderTwenty)
 		{
 			// Assign the school at the index until we reach the average school size
 			if (averageSchoolSize-- > 0)
@@ -92,18 +161,16 @@ std::vector<DiseaseSpreadSimulation::Person> DiseaseSpreadSimulation::PersonPopu
 				}
 			}
 		}
-		// Add the created person to the community
-		population.push_back(std::move(person));
+		// The population doesn't move anymore, so the homes can point to it
+		person.SetHome(assignedHomes.at(index));
 	}
 
-	AssigneHomesToPopulation(population, homes, country);
-
 	return population;
 }
 
-DiseaseSpreadSimulation::Person DiseaseSpreadSimulation::PersonPopulator::GetNewPerson(Community* community, Home* home)
+DiseaseSpreadSimulation::Statistics::HumanDistribution DiseaseSpreadSimulation::PersonPopulator::NextHumanDistribution()
 {
-	// As long as we don't have assigned the full population create a new person with age and sex according to our distribution
+	// As long as we don't have assigned the full population return the age and sex according to our distribution
 	// When the currentHumanCount is 0...
 	if (m_currentHumanCount == 0)
 	{
@@ -137,12 +204,12 @@ DiseaseSpreadSimulation::Person DiseaseSpreadSimulation::PersonPopulator::GetNew
 		m_allAssigned = true;
 	}
 
-	return {m_currentHumanDistribution.ageGroup, m_currentHumanDistribution.sex, PersonBehavior(), community, home};
+	return m_currentHumanDistribution;
 }
 
 size_t DiseaseSpreadSimulation::PersonPopulator::WorkingPeopleCount(const size_t populationSize, const Country country)
 {
-	// TODO: Need a better way to get the working people. Not in sync with PersonPopulator::GetNewPerson()
+	// TODO: Need a better way to get the working people. Not in sync with PersonPopulator::NextHumanDistribution()
 	auto countryDistribution = GetCountryDistribution(country);
 	// Sum up every human distribution inside working age (>20 and <70).
 	return std::accumulate(countryDistribution.begin(), countryDistribution.end(), static_cast<size_t>(0), [populationSize](size_t people, const DiseaseSpreadSimulation::Statistics::HumanDistribution& humanDistribution)
@@ -202,49 +269,35 @@ size_t DiseaseSpreadSimulation::PersonPopulator::DistributionToCountHelper(size_
 	return static_cast<size_t>(static_cast<double>(count) * static_cast<double>(percent));
 }
 
-DiseaseSpreadSimulation::Home* DiseaseSpreadSimulation::PersonPopulator::AssignHome(const Country country, const Age_Group ageGroup, const std::array<std::vector<Home*>, 4>& homesByMemberCount)
+Random::AliasTable DiseaseSpreadSimulation::PersonPopulator::HomeSizeTable(const Country country)
 {
-	// Create the distribution
-	std::array<double, 4> distributionArray{static_cast<double>(PersonPopulator::GetHouseholdDistribution(country).oneMember),
-		static_cast<double>(PersonPopulator::GetHouseholdDistribution(country).twoToThreeMembers),
-		static_cast<double>(PersonPopulator::GetHouseholdDistribution(country).fourToFiveMembers),
-		static_cast<double>(PersonPopulator::GetHouseholdDistribution(country).sixPlusMembers)};
+	const auto householdDistribution = GetHouseholdDistribution(country);
+	return Random::AliasTable{std::array<float, 4>{householdDistribution.oneMember,
+		householdDistribution.twoToThreeMembers,
+		householdDistribution.fourToFiveMembers,
+		householdDistribution.sixPlusMembers}};
+}
 
-	size_t distIndex{GetDistributedArrayIndex(distributionArray)};
+DiseaseSpreadSimulation::Home* DiseaseSpreadSimulation::PersonPopulator::AssignHome(const Age_Group ageGroup, const Random::AliasTable& homeSizeTable, const std::array<std::vector<Home*>, 4>& homesByMemberCount)
+{
+	size_t distIndex{homeSizeTable()};
 	// Get a new index when the vector is empty or the person is under twenty and the index is for one member homes
 	while (homesByMemberCount.at(distIndex).empty() || (ageGroup <= Age_Group::UnderTwenty && distIndex == 0))
 	{
-		distIndex = GetDistributedArrayIndex(distributionArray);
+		distIndex = homeSizeTable();
 	}
 	// Return a random home of the chosen size
 	return homesByMemberCount.at(distIndex).at(Random::RandomVectorIndex(homesByMemberCount.at(distIndex)));
 }
 
-void DiseaseSpreadSimulation::PersonPopulator::AssigneHomesToPopulation(std::vector<Person>& population, std::vector<Home>& homesToAssigne, Country country)
-{
-	std::vector<Home*> homes{};
-	homes.reserve(homesToAssigne.size());
-	std::transform(homesToAssigne.begin(), homesToAssigne.end(), std::back_inserter(homes), [](auto& home)
-		{
-			return &home;
-		});
-
-	auto homesByMemberCount = PersonPopulator::HomesByMemberCount(population.size(), country, homes);
-
-	for (auto& person : population)
-	{
-		person.SetHome(PersonPopulator::AssignHome(country, person.GetAgeGroup(), homesByMemberCount));
-	}
-}
-
-DiseaseSpreadSimulation::Workplace* DiseaseSpreadSimulation::PersonPopulator::AssignWorkplace(const std::array<std::vector<Workplace*>, 5>& workplacesBySize) // NOLINT(*-magic-numbers)
+DiseaseSpreadSimulation::Workplace* DiseaseSpreadSimulation::PersonPopulator::AssignWorkplace(const Random::AliasTable& workplaceSizeTable, const std::array<std::vector<Workplace*>, 5>& workplacesBySize) // NOLINT(*-magic-numbers)
 {
 	// TODO: Implement Supply, HardwareStore and Morgue as a workplace. Currently ignored
-	size_t distIndex{GetDistributedArrayIndex(Statistics::workplaceSizePercent)};
+	size_t distIndex{workplaceSizeTable()};
 	// Get a new index until the vector is not empty
 	while (workplacesBySize.at(distIndex).empty())
 	{
-		distIndex = GetDistributedArrayIndex(Statistics::workplaceSizePercent);
+		distIndex = workplaceSizeTable();
 	}
 	// Return a random workplace at the chosen size
 	return workplacesBySize.at(distIndex).at(Random::RandomVectorIndex(workplacesBySize.at(distIndex)));
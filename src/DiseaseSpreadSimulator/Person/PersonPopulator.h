@@ -1,5 +1,4 @@
 #pragma once
-#include <random>
 #include <vector>
 #include "Enums.h"
 #include "Statistics.h"
@@ -10,43 +9,41 @@ namespace DiseaseSpreadSimulation
 {
 	class Person;
 	class Community;
+	class ThreadPool;
 
 	class PersonPopulator
 	{
 	public:
 		PersonPopulator(const size_t populationSize, std::vector<Statistics::HumanDistribution> humanDistribution);
 
-		std::vector<Person> CreatePopulation(Country country, std::vector<Home>& homes, std::vector<Workplace>& workplaces, std::vector<School>& schools, Community* community);
+		// The chunks run on the pool when one is given and one after another otherwise. The population is the same either way.
+		std::vector<Person> CreatePopulation(Country country, std::vector<Home>& homes, std::vector<Workplace>& workplaces, std::vector<School>& schools, Community* community, ThreadPool* pool = nullptr);
 
 		static size_t WorkingPeopleCount(const size_t populationSize, const Country country);
 		static float WorkingPeopleCountFloat(const size_t populationSize, const Country country);
 		static size_t SchoolKidsCount(const size_t populationSize, const Country country);
 		static std::array<std::vector<Home*>, 4> HomesByMemberCount(const size_t populationSize, const Country country, const std::vector<Home*>& homes);
-		static Home* AssignHome(const Country country, const Age_Group ageGroup, const std::array<std::vector<Home*>, 4>& homesByMemberCount);
+		// Picks the home sizes of homesByMemberCount
+		static Random::AliasTable HomeSizeTable(const Country country);
+		static Home* AssignHome(const Age_Group ageGroup, const Random::AliasTable& homeSizeTable, const std::array<std::vector<Home*>, 4>& homesByMemberCount);
 
 		static void AddCommunityToPopulation(Community* community, std::vector<Person>& population);
 
 		static Statistics::HouseholdComposition GetHouseholdDistribution(Country country);
 		static std::vector<Statistics::HumanDistribution> GetCountryDistribution(Country country);
 
+		// People are created in chunks of this size in parallel. Every chunk draws from its own stream,
+		// so the population only depends on the seed and not on the thread count.
+		static constexpr size_t chunkSize{4096U};
+
 	private:
-		// Get a new person for the chosen distribution.
-		Person GetNewPerson(Community* community = nullptr, Home* home = nullptr);
+		// Get the age and sex of the next person for the chosen distribution
+		Statistics::HumanDistribution NextHumanDistribution();
 
 		// Returns a rounded down percentage of count
 		static size_t DistributionToCountHelper(size_t count, float percent);
 
-		static void AssigneHomesToPopulation(std::vector<Person>& population, std::vector<Home>& homesToAssigne, Country country);
-		static Workplace* AssignWorkplace(const std::array<std::vector<Workplace*>, 5>& workplacesBySize);
-
-		// Returns an index weighted by the given distribution
-		template <typename T, size_t SIZE>
-		static size_t GetDistributedArrayIndex(const std::array<T, SIZE>& distributionArray)
-		{
-			// Create the distribution with the distributionArray as weights
-			std::discrete_distribution<size_t> distribution(distributionArray.cbegin(), distributionArray.cend());
-			return distribution(Random::generator);
-		}
+		static Workplace* AssignWorkplace(const Random::AliasTable& workplaceSizeTable, const std::array<std::vector<Workplace*>, 5>& workplacesBySize);
 
 	private:
 		const size_t m_populationSize{};
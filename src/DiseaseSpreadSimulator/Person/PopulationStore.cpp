@@ -0,0 +1,276 @@
+#include "Person/PopulationStore.h"
+#include "Person/Person.h"
+
+DiseaseSpreadSimulation::PopulationStore::PopulationStore(const PopulationStore& other)
+	: rowCounters(other.rowCounters)
+{
+	SetCounters(other.Count());
+}
+
+DiseaseSpreadSimulation::PopulationStore& DiseaseSpreadSimulation::PopulationStore::operator=(const PopulationStore& other)
+{
+	if (this != &other)
+	{
+		rowCounters = other.rowCounters;
+		SetCounters(other.Count());
+	}
+	return *this;
+}
+
+void DiseaseSpreadSimulation::PopulationStore::Assign(std::vector<Person>& population)
+{
+	const auto size = population.size();
+	rowCounters.assign(size, 0U);
+
+	for (uint32_t row = 0U; row < static_cast<uint32_t>(size); row++)
+	{
+		population[row].m_storeRow = row;
+		Write(row, population[row]);
+	}
+	// The counters of a former population are replaced as a whole
+	SetCounters(Recount());
+}
+
+void DiseaseSpreadSimulation::PopulationStore::Clear()
+{
+	rowCounters.clear();
+	SetCounters({});
+}
+
+void DiseaseSpreadSimulation::PopulationStore::Append(Person& person)
+{
+	if (!counterShards)
+	{
+		SetCounters({});
+	}
+	const auto row = static_cast<uint32_t>(rowCounters.size());
+	// Counted nowhere until the write moves it to the counters of the person
+	rowCounters.push_back(0U);
+
+	person.m_storeRow = row;
+	Write(row, person);
+}
+
+void DiseaseSpreadSimulation::PopulationStore::Erase(uint32_t row, std::vector<Person>& population)
+{
+	AddCounters(rowCounters[row], -1);
+	rowCounters.erase(rowCounters.begin() + static_cast<std::ptrdiff_t>(row));
+
+	for (auto index = row; index < static_cast<uint32_t>(population.size()); index++)
+	{
+		population[index].m_storeRow = index;
+	}
+}
+
+void DiseaseSpreadSimulation::PopulationStore::Unassign(Person& person)
+{
+	person.m_storeRow = noRow;
+}
+
+void DiseaseSpreadSimulation::PopulationStore::Write(uint32_t row, const Person& person)
+{
+	uint8_t rowFlags{0U};
+	if (person.alive)
+	{
+		rowFlags |= Alive;
+	}
+	if (person.isTraveling)
+	{
+		rowFlags |= Traveling;
+	}
+	if (person.isQuarantined)
+	{
+		rowFlags |= Quarantined;
+	}
+	if (person.infection.HasDisease())
+	{
+		rowFlags |= HasDisease;
+	}
+	if (person.infection.HasRecovered())
+	{
+		rowFlags |= HasRecovered;
+	}
+
+	// Most writes don't change the status of the person
+	const auto oldCounters = rowCounters[row];
+	const auto newCounters = CountersOf(person.infection.GetSeirState(), rowFlags);
+	if (newCounters == oldCounters)
+	{
+		return;
+	}
+	rowCounters[row] = newCounters;
+	if (!counterShards)
+	{
+		return;
+	}
+	AddCounters(static_cast<uint16_t>(newCounters & ~oldCounters), 1);
+	AddCounters(static_cast<uint16_t>(oldCounters & ~newCounters), -1);
+}
+
+size_t DiseaseSpreadSimulation::PopulationStore::Size() const
+{
+	return rowCounters.size();
+}
+
+DiseaseSpreadSimulation::PopulationCounts DiseaseSpreadSimulation::PopulationStore::Count() const
+{
+	if (!counterShards)
+	{
+		return {};
+	}
+
+	std::array<int64_t, CounterCount> totals{};
+	for (const auto& shard : *counterShards)
+	{
+		for (size_t counter = 0; counter < totals.size(); counter++)
+		{
+			totals.at(counter) += shard.values.at(counter).load(std::memory_order_relaxed);
+		}
+	}
+
+	const auto total = [&totals](Counter counter)
+	{
+		return static_cast<size_t>(totals.at(counter));
+	};
+	return {total(CountAlive),
+		total(CountSusceptible),
+		total(CountExposed),
+		total(CountInfectious),
+		total(CountRecovered),
+		total(CountWithDisease),
+		total(CountTraveling),
+		total(CountQuarantined),
+		total(CountDead),
+		total(CountEverInfected)};
+}
+
+DiseaseSpreadSimulation::PopulationCounts DiseaseSpreadSimulation::PopulationStore::Recount() const
+{
+	PopulationCounts counts{};
+
+	for (const auto counters : rowCounters)
+	{
+		const auto add = [counters](size_t& count, Counter counter)
+		{
+			count += static_cast<size_t>((static_cast<uint32_t>(counters) >> static_cast<uint32_t>(counter)) & 1U);
+		};
+		add(counts.alive, CountAlive);
+		add(counts.susceptible, CountSusceptible);
+		add(counts.exposed, CountExposed);
+		add(counts.infectious, CountInfectious);
+		add(counts.recovered, CountRecovered);
+		add(counts.withDisease, CountWithDisease);
+		add(counts.traveling, CountTraveling);
+		add(counts.quarantined, CountQuarantined);
+		add(counts.dead, CountDead);
+		add(counts.everInfected, CountEverInfected);
+	}
+
+	return counts;
+}
+
+uint16_t DiseaseSpreadSimulation::PopulationStore::CountersOf(Seir_State seirState, uint8_t rowFlags)
+{
+	const auto bit = [](Counter counter)
+	{
+		return static_cast<uint16_t>(1U << counter);
+	};
+
+	uint16_t counters{0U};
+	// Every person that is dead, has recovered or has a disease is or was infected
+	if ((rowFlags & (HasDisease | HasRecovered)) != 0U || (rowFlags & Alive) == 0U)
+	{
+		counters |= bit(CountEverInfected);
+	}
+
+	if ((rowFlags & Alive) == 0U)
+	{
+		return counters | bit(CountDead);
+	}
+
+	counters |= bit(CountAlive);
+	switch (seirState)
+	{
+	case Seir_State::Susceptible:
+		counters |= bit(CountSusceptible);
+		break;
+	case Seir_State::Exposed:
+		counters |= bit(CountExposed);
+		break;
+	case Seir_State::Infectious:
+		counters |= bit(CountInfectious);
+		break;
+	case Seir_State::Recovered:
+		counters |= bit(CountRecovered);
+		break;
+	default:
+		break;
+	}
+	if ((rowFlags & HasDisease) != 0U && seirState != Seir_State::Susceptible)
+	{
+		counters |= bit(CountWithDisease);
+	}
+	if ((rowFlags & Traveling) != 0U)
+	{
+		counters |= bit(CountTraveling);
+	}
+	if ((rowFlags & Quarantined) != 0U)
+	{
+		counters |= bit(CountQuarantined);
+	}
+	return counters;
+}
+
+size_t DiseaseSpreadSimulation::PopulationStore::ShardOfThisThread()
+{
+	static std::atomic<size_t> nextShard{0U};
+	thread_local const size_t shard = nextShard.fetch_add(1U, std::memory_order_relaxed) % shardCount;
+	return shard;
+}
+
+void DiseaseSpreadSimulation::PopulationStore::AddCounters(uint16_t counters, int64_t change)
+{
+	if (counters == 0U)
+	{
+		return;
+	}
+	auto& shard = (*counterShards)[ShardOfThisThread()];
+	for (uint8_t counter = 0U; counter < CounterCount; counter++)
+	{
+		if ((counters & (1U << counter)) != 0U)
+		{
+			shard.values.at(counter).fetch_add(change, std::memory_order_relaxed);
+		}
+	}
+}
+
+void DiseaseSpreadSimulation::PopulationStore::SetCounters(const PopulationCounts& counts)
+{
+	if (!counterShards)
+	{
+		counterShards = std::make_unique<CounterShards>();
+	}
+	for (auto& shard : *counterShards)
+	{
+		for (auto& value : shard.values)
+		{
+			value.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	auto& values = counterShards->front().values;
+	const auto set = [&values](Counter counter, size_t count)
+	{
+		values.at(counter).store(static_cast<int64_t>(count), std::memory_order_relaxed);
+	};
+	set(CountAlive, counts.alive);
+	set(CountSusceptible, counts.susceptible);
+	set(CountExposed, counts.exposed);
+	set(CountInfectious, counts.infectious);
+	set(CountRecovered, counts.recovered);
+	set(CountWithDisease, counts.withDisease);
+	set(CountTraveling, counts.traveling);
+	set(CountQuarantined, counts.quarantined);
+	set(CountDead, counts.dead);
+	set(CountEverInfected, counts.everInfected);
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "Enums.h"
+
+namespace DiseaseSpreadSimulation
+{
+	class Person;
+
+	// Snapshot of the population status counted from the store
+	struct PopulationCounts
+	{
+		size_t alive{0};
+		size_t susceptible{0};
+		size_t exposed{0};
+		size_t infectious{0};
+		size_t recovered{0};
+		// Alive persons that currently carry a disease
+		size_t withDisease{0};
+		size_t traveling{0};
+		size_t quarantined{0};
+		size_t dead{0};
+		// Every person that is dead, has recovered or has a disease is or was infected
+		size_t everInfected{0};
+	};
+
+	// Incremental status counters of the population of a community. The persons stay the owners of their state.
+	// Every person of a community owns one row with the counters it is counted in and writes its state into it on every change.
+	// Every write moves the row between the counters, so counting the population doesn't touch the persons or the rows at all.
+	class PopulationStore
+	{
+	public:
+		PopulationStore() = default;
+		PopulationStore(const PopulationStore& other);
+		PopulationStore(PopulationStore&& other) noexcept = default;
+		PopulationStore& operator=(const PopulationStore& other);
+		PopulationStore& operator=(PopulationStore&& other) noexcept = default;
+		~PopulationStore() = default;
+
+		// Give every person a row at the index it has inside the population and write its current state
+		void Assign(std::vector<Person>& population);
+		void Clear();
+		// Give the person that was added at the end of the population the next row and count its current state
+		void Append(Person& person);
+		// Drop the row of a person that was erased from the population. The following persons move up one row like they did inside the population.
+		void Erase(uint32_t row, std::vector<Person>& population);
+		// Take the row from a person that leaves the population
+		static void Unassign(Person& person);
+		// Write the current state of the person into the row. Rows of different persons can be written at the same time.
+		void Write(uint32_t row, const Person& person);
+
+		[[nodiscard]] size_t Size() const;
+
+		// Sums the counters. Should not be called while rows are written.
+		[[nodiscard]] PopulationCounts Count() const;
+		// Walks every row to count them. Only used to build the counters and to check them.
+		[[nodiscard]] PopulationCounts Recount() const;
+
+		static constexpr uint32_t noRow{std::numeric_limits<uint32_t>::max()};
+
+	private:
+		enum Flag : uint8_t
+		{
+			Alive = 1U << 0U,
+			Traveling = 1U << 1U,
+			Quarantined = 1U << 2U,
+			HasDisease = 1U << 3U,
+			HasRecovered = 1U << 4U
+		};
+		enum Counter : uint8_t
+		{
+			CountAlive,
+			CountSusceptible,
+			CountExposed,
+			CountInfectious,
+			CountRecovered,
+			CountWithDisease,
+			CountTraveling,
+			CountQuarantined,
+			CountDead,
+			CountEverInfected,
+			CounterCount
+		};
+
+		// Every thread changes the counters of its own shard, so the parallel updates rarely share a cache line.
+		// Single shards can become negative, only their sum is meaningful.
+		static constexpr size_t shardCount{16U};
+		struct alignas(64) CounterShard // NOLINT(*-magic-numbers): Cache line size
+		{
+			std::array<std::atomic<int64_t>, CounterCount> values{};
+		};
+		using CounterShards = std::array<CounterShard, shardCount>;
+
+		// Bit mask of the counters a row with this state counts for
+		static uint16_t CountersOf(Seir_State seirState, uint8_t rowFlags);
+		static size_t ShardOfThisThread();
+		// Add or subtract one row from every counter of the mask
+		void AddCounters(uint16_t counters, int64_t change);
+		void SetCounters(const PopulationCounts& counts);
+
+		// Bit mask of the counters every row is counted in. A new row is counted nowhere.
+		std::vector<uint16_t> rowCounters{};
+		std::unique_ptr<CounterShards> counterShards{};
+	};
+} // namespace DiseaseSpreadSimulation
@@ -1,14 +1,83 @@
 #include "Places/Community.h"
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <utility>
 #include <mutex>
+#include <stdexcept>
 #include "Places/PlaceBuilder.h"
 #include "Person/Person.h"
 #include "Person/PersonPopulator.h"
 #include "RandomNumbers.h"
 #include "IDGenerator/IDGenerator.h"
+#include "Simulation/MeasureTime.h"
 
-DiseaseSpreadSimulation::Community::Community(const size_t populationSize, const Country country)
+namespace
+{
+	// Homes, workplaces and schools reserve about this many people per person
+	constexpr size_t reservedPerPerson{3U};
+
+	// Returns the index of the place inside the places or Snapshot::noIndex when it is not one of them
+	template <typename T>
+	uint32_t IndexOfPlace(const std::vector<T>& placesOfType, const DiseaseSpreadSimulation::Place* place)
+	{
+		if (placesOfType.empty())
+		{
+			return DiseaseSpreadSimulation::Snapshot::noIndex;
+		}
+		// Only compare the addresses. The place could be anywhere and is not touched before we know it is inside the vector.
+		const DiseaseSpreadSimulation::Place* first = &placesOfType.front();
+		const DiseaseSpreadSimulation::Place* last = &placesOfType.back();
+		if (std::less<>{}(place, first) || std::less<>{}(last, place))
+		{
+			return DiseaseSpreadSimulation::Snapshot::noIndex;
+		}
+		return static_cast<uint32_t>(static_cast<const T*>(place) - placesOfType.data());
+	}
+
+	template <typename T>
+	void SavePlaces(DiseaseSpreadSimulation::BinaryWriter& writer, const std::vector<T>& placesOfType, const std::vector<DiseaseSpreadSimulation::Person>& population)
+	{
+		for (const auto& place : placesOfType)
+		{
+			place.Save(writer, population);
+		}
+	}
+
+	template <typename T>
+	void LoadPlaces(DiseaseSpreadSimulation::BinaryReader& reader, std::vector<T>& placesOfType, std::vector<DiseaseSpreadSimulation::Person>& population)
+	{
+		for (auto& place : placesOfType)
+		{
+			place.Load(reader, population);
+			IDGenerator::IDGenerator<T>::SkipPast(place.GetID());
+		}
+	}
+
+	// Returns the place at the index the place has inside the source places or nullptr when it is not one of them
+	template <typename T>
+	T* PlaceAtSameIndex(const std::vector<T>& sourcePlaces, std::vector<T>& placesOfType, const DiseaseSpreadSimulation::Place* place)
+	{
+		const auto index = IndexOfPlace(sourcePlaces, place);
+		if (index == DiseaseSpreadSimulation::Snapshot::noIndex || index >= placesOfType.size())
+		{
+			return nullptr;
+		}
+		return &placesOfType[index];
+	}
+
+	template <typename T>
+	DiseaseSpreadSimulation::Place* PlaceAt(std::vector<T>& placesOfType, uint32_t index)
+	{
+		if (index == DiseaseSpreadSimulation::Snapshot::noIndex)
+		{
+			return nullptr;
+		}
+		return &placesOfType[index];
+	}
+} // namespace
+
+DiseaseSpreadSimulation::Community::Community(const size_t populationSize, const Country country, ThreadPool* pool)
 	: m_id(IDGenerator::IDGenerator<Community>::GetNextID())
 {
 	// Return early and leave places and population empty with a population size of 0
@@ -17,10 +86,63 @@ DiseaseSpreadSimulation::Community::Community(const size_t populationSize, const
 		return;
 	}
 
-	m_places = PlaceBuilder::CreatePlaces(populationSize, country);
+	m_placeArena = std::make_unique<PlaceArena>(populationSize * reservedPerPerson * sizeof(Person*));
+	m_places = PlaceBuilder::CreatePlaces(populationSize, country, m_placeArena.get());
 
 	PersonPopulator populationFactory(populationSize, PersonPopulator::GetCountryDistribution(country));
-	m_population = populationFactory.CreatePopulation(country, m_places.homes, m_places.workplaces, m_places.schools, this);
+	m_population = populationFactory.CreatePopulation(country, m_places.homes, m_places.workplaces, m_places.schools, this, pool);
+	PopulationChanged();
+}
+
+DiseaseSpreadSimulation::Community::Community(const std::vector<CachedPerson>& population, const Country country)
+	: m_id(IDGenerator::IDGenerator<Community>::GetNextID())
+{
+	if (population.empty())
+	{
+		return;
+	}
+
+	m_placeArena = std::make_unique<PlaceArena>(population.size() * reservedPerPerson * sizeof(Person*));
+	m_places = PlaceBuilder::CreatePlaces(population.size(), country, m_placeArena.get());
+
+	const auto placeAt = [](auto& placesOfType, uint32_t index)
+	{
+		if (index == Snapshot::noIndex)
+		{
+			return static_cast<decltype(placesOfType.data())>(nullptr);
+		}
+		if (index >= placesOfType.size())
+		{
+			throw std::runtime_error("The cached population contains an index out of range!");
+		}
+		return &placesOfType[index];
+	};
+
+	uint32_t lastID{0U};
+	m_population.reserve(population.size());
+	for (const auto& cached : population)
+	{
+		auto& person = m_population.emplace_back(cached.age, cached.sex, PersonBehavior(cached.foodBuyInterval, cached.hardwareBuyInterval, cached.acceptanceFactor, cached.travelNeed), this, nullptr, cached.id);
+		person.workplace = placeAt(m_places.workplaces, cached.workplace);
+		person.school = placeAt(m_places.schools, cached.school);
+		person.canWorkFromHome = cached.canWorkFromHome;
+		person.hasCriticalInfrastructureJob = cached.hasCriticalInfrastructureJob;
+		person.m_randomStream = Random::Engine{cached.randomState};
+		lastID = std::max(lastID, cached.id);
+	}
+	IDGenerator::IDGenerator<Person>::SkipPast(lastID);
+
+	// The population doesn't move anymore, so the homes can point to it
+	for (size_t index = 0; index < population.size(); index++)
+	{
+		auto* home = placeAt(m_places.homes, population[index].home);
+		if (home == nullptr)
+		{
+			throw std::runtime_error("The cached population contains a person without a home!");
+		}
+		m_population[index].SetHome(home);
+	}
+	PopulationChanged();
 }
 
 // We don't want to copy mutexes so we suppress the static analyzer warning
@@ -28,11 +150,16 @@ DiseaseSpreadSimulation::Community::Community(const size_t populationSize, const
 DiseaseSpreadSimulation::Community::Community(const Community& other)
 	: m_id(IDGenerator::IDGenerator<Community>::GetNextID()),
 	  m_population(other.m_population),
+	  m_populationStore(other.m_populationStore),
 	  m_places(other.m_places),
 	  m_travelLocation(other.m_travelLocation),
+	  m_containmentMeasures(other.m_containmentMeasures),
+	  m_deferTransfers(other.m_deferTransfers),
+	  m_placeTable(other.m_placeTable),
 	  m_positiveTests(other.m_positiveTests),
 	  m_personsQuarantined(other.m_personsQuarantined)
 {
+	RebindFrom(other);
 }
 
 // We don't want to copy mutexes so we suppress the static analyzer warning
@@ -40,11 +167,18 @@ DiseaseSpreadSimulation::Community::Community(const Community& other)
 DiseaseSpreadSimulation::Community::Community(Community&& other) noexcept
 	: m_id(other.m_id),
 	  m_population(std::move(other.m_population)),
+	  m_populationStore(std::move(other.m_populationStore)),
+	  m_updateScheduler(std::move(other.m_updateScheduler)),
+	  m_placeArena(std::move(other.m_placeArena)),
 	  m_places(std::move(other.m_places)),
 	  m_travelLocation(std::move(other.m_travelLocation)),
+	  m_containmentMeasures(std::move(other.m_containmentMeasures)),
+	  m_deferTransfers(other.m_deferTransfers),
+	  m_placeTable(std::move(other.m_placeTable)),
 	  m_positiveTests(other.m_positiveTests),
 	  m_personsQuarantined(other.m_personsQuarantined)
 {
+	RebindCommunity(&other.m_travelLocation);
 }
 
 DiseaseSpreadSimulation::Community& DiseaseSpreadSimulation::Community::operator=(const Community& other)
@@ -57,29 +191,143 @@ DiseaseSpreadSimulation::Community& DiseaseSpreadSimulation::Community::operator
 DiseaseSpreadSimulation::Community& DiseaseSpreadSimulation::Community::operator=(Community&& other) noexcept
 {
 	std::swap(m_population, other.m_population);
+	std::swap(m_populationStore, other.m_populationStore);
+	std::swap(m_updateScheduler, other.m_updateScheduler);
+	std::swap(m_placeArena, other.m_placeArena);
 	std::swap(m_places, other.m_places);
 	std::swap(m_travelLocation, other.m_travelLocation);
+	std::swap(m_containmentMeasures, other.m_containmentMeasures);
+	std::swap(m_deferTransfers, other.m_deferTransfers);
+	std::swap(m_placeTable, other.m_placeTable);
 	std::swap(m_positiveTests, other.m_positiveTests);
 	std::swap(m_personsQuarantined, other.m_personsQuarantined);
+	// The persons were swapped, so each side still points at the travel location of the other one
+	RebindCommunity(&other.m_travelLocation);
+	other.RebindCommunity(&m_travelLocation);
 	return *this;
 }
 
+void DiseaseSpreadSimulation::Community::RebindFrom(const Community& source)
+{
+	for (auto& person : m_population)
+	{
+		person.m_community = this;
+		person.m_home = static_cast<Home*>(CorrespondingPlace(source, person.m_home));
+		person.whereabouts = CorrespondingPlace(source, person.whereabouts);
+		person.workplace = static_cast<Workplace*>(CorrespondingPlace(source, person.workplace));
+		person.school = static_cast<School*>(CorrespondingPlace(source, person.school));
+		person.m_slotPlace = CorrespondingPlace(source, person.m_slotPlace);
+	}
+
+	const auto rebindPeople = [this, &source](Place& place)
+	{
+		for (auto*& person : place.GetPeople())
+		{
+			person = CorrespondingPerson(source, person);
+		}
+	};
+	const auto rebindPlaces = [&rebindPeople](auto& placesOfType)
+	{
+		for (auto& place : placesOfType)
+		{
+			rebindPeople(place);
+		}
+	};
+	rebindPlaces(m_places.homes);
+	rebindPlaces(m_places.supplyStores);
+	rebindPlaces(m_places.workplaces);
+	rebindPlaces(m_places.schools);
+	rebindPlaces(m_places.hardwareStores);
+	rebindPlaces(m_places.morgues);
+	rebindPeople(m_travelLocation);
+}
+
+DiseaseSpreadSimulation::Place* DiseaseSpreadSimulation::Community::CorrespondingPlace(const Community& source, Place* place)
+{
+	if (place == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Only the places of the same type are searched
+	Place* corresponding{nullptr};
+	switch (place->GetType())
+	{
+	case Place_Type::Home:
+		corresponding = PlaceAtSameIndex(source.m_places.homes, m_places.homes, place);
+		break;
+	case Place_Type::Supply:
+		corresponding = PlaceAtSameIndex(source.m_places.supplyStores, m_places.supplyStores, place);
+		break;
+	case Place_Type::Workplace:
+		corresponding = PlaceAtSameIndex(source.m_places.workplaces, m_places.workplaces, place);
+		break;
+	case Place_Type::School:
+		corresponding = PlaceAtSameIndex(source.m_places.schools, m_places.schools, place);
+		break;
+	case Place_Type::HardwareStore:
+		corresponding = PlaceAtSameIndex(source.m_places.hardwareStores, m_places.hardwareStores, place);
+		break;
+	case Place_Type::Morgue:
+		corresponding = PlaceAtSameIndex(source.m_places.morgues, m_places.morgues, place);
+		break;
+	case Place_Type::Travel:
+		corresponding = place == &source.m_travelLocation ? &m_travelLocation : nullptr;
+		break;
+	default:
+		break;
+	}
+	return corresponding != nullptr ? corresponding : place;
+}
+
+DiseaseSpreadSimulation::Person* DiseaseSpreadSimulation::Community::CorrespondingPerson(const Community& source, Person* person)
+{
+	const auto& sourcePopulation = source.m_population;
+	if (sourcePopulation.empty() || std::less<>{}(person, sourcePopulation.data()) || !std::less<>{}(person, sourcePopulation.data() + sourcePopulation.size()))
+	{
+		return person;
+	}
+	return &m_population[static_cast<size_t>(person - sourcePopulation.data())];
+}
+
+void DiseaseSpreadSimulation::Community::RebindCommunity(const Place* movedTravelLocation)
+{
+	for (auto& person : m_population)
+	{
+		person.m_community = this;
+		if (person.whereabouts == movedTravelLocation)
+		{
+			person.whereabouts = &m_travelLocation;
+		}
+		if (person.m_slotPlace == movedTravelLocation)
+		{
+			person.m_slotPlace = &m_travelLocation;
+		}
+	}
+}
+
 void DiseaseSpreadSimulation::Community::AddPerson(Person person)
 {
 	person.SetCommunity(this);
 	std::lock_guard<std::shared_mutex> lockAddPerson(populationMutex);
 	m_population.push_back(std::move(person));
+	PersonsAdded(m_population.size() - 1U);
 }
 
 void DiseaseSpreadSimulation::Community::RemovePerson(const Person& personToRemove)
 {
 	std::lock_guard<std::shared_mutex> lockRemovePerson(populationMutex);
-	m_population.erase(
-		std::remove_if(m_population.begin(), m_population.end(), [&](const Person& person)
-			{
-				return person == personToRemove;
-			}),
-		m_population.end());
+	const auto toRemove = std::find_if(m_population.begin(), m_population.end(), [&](const Person& person)
+		{
+			return person == personToRemove;
+		});
+	if (toRemove == m_population.end())
+	{
+		return;
+	}
+	const auto row = static_cast<uint32_t>(std::distance(m_population.begin(), toRemove));
+	m_population.erase(toRemove);
+	PersonRemoved(row);
 }
 
 void DiseaseSpreadSimulation::Community::AddPlaces(Places places)
@@ -91,8 +339,10 @@ void DiseaseSpreadSimulation::Community::AddPlaces(Places places)
 void DiseaseSpreadSimulation::Community::AddPopulation(std::vector<Person>& population)
 {
 	std::lock_guard<std::shared_mutex> lockAddPopulation(populationMutex);
+	const auto first = m_population.size();
 	m_population.reserve(m_population.size() + population.size());
 	m_population.insert(m_population.end(), population.begin(), population.end());
+	PersonsAdded(first);
 }
 
 std::optional<DiseaseSpreadSimulation::Person> DiseaseSpreadSimulation::Community::TransferPerson(const Person& traveler)
@@ -112,8 +362,12 @@ std::optional<DiseaseSpreadSimulation::Person> DiseaseSpreadSimulation::Communit
 	{
 		lockPopulation.lock();
 		std::optional<Person> transferPerson = std::move(*toTransfer);
+		const auto row = static_cast<uint32_t>(std::distance(m_population.begin(), toTransfer));
 		m_population.erase(toTransfer);
+		PersonRemoved(row);
 		lockPopulation.unlock();
+		// The row belongs to this community and not to the traveler
+		PopulationStore::Unassign(*transferPerson);
 		return transferPerson;
 	}
 	// This should never happen, because the person to transfer should be calling it.
@@ -169,6 +423,52 @@ DiseaseSpreadSimulation::Place* DiseaseSpreadSimulation::Community::TransferToTr
 	return &m_travelLocation;
 }
 
+void DiseaseSpreadSimulation::Community::DeferTransfers(bool defer)
+{
+	m_deferTransfers = defer;
+}
+
+void DiseaseSpreadSimulation::Community::ApplyTransfers(const std::vector<uint32_t>& personIndices)
+{
+	PrepareTransfers(personIndices);
+	LeavePlaces(0U, 1U);
+	ArriveAtPlaces(0U, 1U);
+}
+
+void DiseaseSpreadSimulation::Community::ApplyTransfers()
+{
+	PrepareTransfers();
+	LeavePlaces(0U, 1U);
+	ArriveAtPlaces(0U, 1U);
+}
+
+void DiseaseSpreadSimulation::Community::PrepareTransfers(const std::vector<uint32_t>& personIndices)
+{
+	std::vector<Person*> moving{};
+	for (const auto index : personIndices)
+	{
+		auto& person = m_population[index];
+		if (person.m_slotPlace != person.whereabouts)
+		{
+			moving.push_back(&person);
+		}
+	}
+	PrepareTransfers(moving);
+}
+
+void DiseaseSpreadSimulation::Community::PrepareTransfers()
+{
+	std::vector<Person*> moving{};
+	for (auto& person : m_population)
+	{
+		if (person.m_slotPlace != person.whereabouts)
+		{
+			moving.push_back(&person);
+		}
+	}
+	PrepareTransfers(moving);
+}
+
 std::vector<DiseaseSpreadSimulation::Person>& DiseaseSpreadSimulation::Community::GetPopulation()
 {
 	return m_population;
@@ -179,6 +479,21 @@ const std::vector<DiseaseSpreadSimulation::Person>& DiseaseSpreadSimulation::Com
 	return m_population;
 }
 
+DiseaseSpreadSimulation::PopulationStore& DiseaseSpreadSimulation::Community::GetPopulationStore()
+{
+	return m_populationStore;
+}
+
+const DiseaseSpreadSimulation::PopulationStore& DiseaseSpreadSimulation::Community::GetPopulationStore() const
+{
+	return m_populationStore;
+}
+
+DiseaseSpreadSimulation::UpdateScheduler& DiseaseSpreadSimulation::Community::GetUpdateScheduler()
+{
+	return m_updateScheduler;
+}
+
 DiseaseSpreadSimulation::Places& DiseaseSpreadSimulation::Community::GetPlaces()
 {
 	return m_places;
@@ -201,7 +516,6 @@ std::vector<DiseaseSpreadSimulation::Home>& DiseaseSpreadSimulation::Community::
 
 DiseaseSpreadSimulation::Supply* DiseaseSpreadSimulation::Community::GetSupplyStore()
 {
-	std::shared_lock<std::shared_mutex> lockGetPlaces(placesMutex);
 	if (m_places.supplyStores.empty())
 	{
 		return nullptr;
@@ -212,7 +526,6 @@ DiseaseSpreadSimulation::Supply* DiseaseSpreadSimulation::Community::GetSupplySt
 
 DiseaseSpreadSimulation::HardwareStore* DiseaseSpreadSimulation::Community::GetHardwareStore()
 {
-	std::shared_lock<std::shared_mutex> lockGetPlaces(placesMutex);
 	if (m_places.hardwareStores.empty())
 	{
 		return nullptr;
@@ -223,7 +536,6 @@ DiseaseSpreadSimulation::HardwareStore* DiseaseSpreadSimulation::Community::GetH
 
 DiseaseSpreadSimulation::Morgue* DiseaseSpreadSimulation::Community::GetMorgue()
 {
-	std::shared_lock<std::shared_mutex> lockGetPlaces(placesMutex);
 	if (m_places.morgues.empty())
 	{
 		return nullptr;
@@ -280,6 +592,7 @@ const DiseaseSpreadSimulation::DiseaseContainment& DiseaseSpreadSimulation::Comm
 
 void DiseaseSpreadSimulation::Community::TestStation(Person* person)
 {
+	PROFILE_ZONE("TestStation");
 	// Send the person into quarantine when the test is positive and release the person from quarantine if negative
 	if (TestPersonForInfection(person))
 	{
@@ -306,11 +619,7 @@ uint32_t DiseaseSpreadSimulation::Community::GetID() const
 size_t DiseaseSpreadSimulation::Community::CurrentInfectionMax() const
 {
 	std::shared_lock<std::shared_mutex> lockPopulation(populationMutex);
-	return static_cast<size_t>(std::count_if(m_population.begin(), m_population.end(), [](const auto& person)
-		{
-			// Every person that is no longer alive or has recovered or has a disease is or was infected
-			return (!person.IsAlive() || person.HasRecovered() || person.HasDisease());
-		}));
+	return m_populationStore.Count().everInfected;
 }
 
 size_t DiseaseSpreadSimulation::Community::NumberOfPositiveTests() const
@@ -325,6 +634,174 @@ size_t DiseaseSpreadSimulation::Community::NumberOfPersonsQuarantined() const
 	return m_personsQuarantined;
 }
 
+void DiseaseSpreadSimulation::Community::Save(BinaryWriter& writer, const std::vector<Disease>& diseases) const
+{
+	writer.Write(m_id);
+	writer.Write(m_containmentMeasures.IsMaskMandate());
+	writer.Write(m_containmentMeasures.WorkingFromHome());
+	writer.Write(m_containmentMeasures.ShopsAreClosed());
+	writer.Write(m_containmentMeasures.IsLockdown());
+	writer.Write(static_cast<uint64_t>(m_positiveTests));
+	writer.Write(static_cast<uint64_t>(m_personsQuarantined));
+
+	// The places are created first, so the persons can point into them
+	writer.Write(static_cast<uint32_t>(m_places.homes.size()));
+	writer.Write(static_cast<uint32_t>(m_places.supplyStores.size()));
+	writer.Write(static_cast<uint32_t>(m_places.workplaces.size()));
+	writer.Write(static_cast<uint32_t>(m_places.schools.size()));
+	writer.Write(static_cast<uint32_t>(m_places.hardwareStores.size()));
+	writer.Write(static_cast<uint32_t>(m_places.morgues.size()));
+
+	writer.Write(static_cast<uint32_t>(m_population.size()));
+	for (const auto& person : m_population)
+	{
+		person.Save(writer, diseases);
+	}
+
+	SavePlaces(writer, m_places.homes, m_population);
+	SavePlaces(writer, m_places.supplyStores, m_population);
+	SavePlaces(writer, m_places.workplaces, m_population);
+	SavePlaces(writer, m_places.schools, m_population);
+	SavePlaces(writer, m_places.hardwareStores, m_population);
+	SavePlaces(writer, m_places.morgues, m_population);
+	m_travelLocation.Save(writer, m_population);
+}
+
+void DiseaseSpreadSimulation::Community::Load(BinaryReader& reader, const std::vector<Disease>& diseases)
+{
+	m_id = reader.Read<uint32_t>();
+	IDGenerator::IDGenerator<Community>::SkipPast(m_id);
+	m_containmentMeasures.SetMaskMandate(reader.ReadBool());
+	m_containmentMeasures.SetWorkingFromHome(reader.ReadBool());
+	m_containmentMeasures.SetShopsClosed(reader.ReadBool());
+	m_containmentMeasures.SetLockdown(reader.ReadBool());
+	m_positiveTests = reader.Read<uint64_t>();
+	m_personsQuarantined = reader.Read<uint64_t>();
+
+	m_places = Places{};
+	m_places.homes.resize(reader.ReadCount(Place::minSnapshotSize));
+	m_places.supplyStores.resize(reader.ReadCount(Place::minSnapshotSize));
+	m_places.workplaces.resize(reader.ReadCount(Place::minSnapshotSize));
+	m_places.schools.resize(reader.ReadCount(Place::minSnapshotSize));
+	m_places.hardwareStores.resize(reader.ReadCount(Place::minSnapshotSize));
+	m_places.morgues.resize(reader.ReadCount(Place::minSnapshotSize));
+
+	// Reserve to keep the persons in place while the places point to them
+	const auto populationSize = reader.ReadCount(Person::minSnapshotSize);
+	m_population.clear();
+	m_population.reserve(populationSize);
+	for (uint32_t i = 0U; i < populationSize; i++)
+	{
+		m_population.emplace_back(Age_Group::UnderTen, Sex::Male, PersonBehavior(0U, 0U, 0.F, 0.F), this);
+		m_population.back().Load(reader, diseases);
+	}
+
+	LoadPlaces(reader, m_places.homes, m_population);
+	LoadPlaces(reader, m_places.supplyStores, m_population);
+	LoadPlaces(reader, m_places.workplaces, m_population);
+	LoadPlaces(reader, m_places.schools, m_population);
+	LoadPlaces(reader, m_places.hardwareStores, m_population);
+	LoadPlaces(reader, m_places.morgues, m_population);
+	m_travelLocation.Load(reader, m_population);
+	IDGenerator::IDGenerator<Travel>::SkipPast(m_travelLocation.GetID());
+
+	m_deferTransfers = false;
+	PopulationChanged();
+}
+
+std::vector<DiseaseSpreadSimulation::CachedPerson> DiseaseSpreadSimulation::Community::CachePopulation() const
+{
+	std::vector<CachedPerson> population{};
+	population.reserve(m_population.size());
+	for (const auto& person : m_population)
+	{
+		const auto& behavior = person.m_behavior;
+		population.push_back({person.m_randomStream.GetState(),
+			person.id,
+			IndexOfPlace(m_places.homes, person.m_home),
+			IndexOfPlace(m_places.workplaces, person.workplace),
+			IndexOfPlace(m_places.schools, person.school),
+			behavior.foodBuyInterval,
+			behavior.hardwareBuyInterval,
+			behavior.acceptanceFactor,
+			behavior.travelNeed,
+			person.m_age,
+			person.m_sex,
+			person.canWorkFromHome,
+			person.hasCriticalInfrastructureJob,
+			{}});
+	}
+	return population;
+}
+
+void DiseaseSpreadSimulation::Community::WritePlace(BinaryWriter& writer, const Place* place) const
+{
+	const auto write = [&writer](Place_Type type, uint32_t index)
+	{
+		writer.Write(type);
+		writer.Write(index);
+	};
+	const auto writeWhenInside = [&write, place](Place_Type type, const auto& placesOfType)
+	{
+		const auto index = IndexOfPlace(placesOfType, place);
+		if (index == Snapshot::noIndex)
+		{
+			return false;
+		}
+		write(type, index);
+		return true;
+	};
+
+	if (place == nullptr)
+	{
+		write(Place_Type::Home, Snapshot::noIndex);
+		return;
+	}
+	if (writeWhenInside(Place_Type::Home, m_places.homes) ||
+		writeWhenInside(Place_Type::Supply, m_places.supplyStores) ||
+		writeWhenInside(Place_Type::Workplace, m_places.workplaces) ||
+		writeWhenInside(Place_Type::School, m_places.schools) ||
+		writeWhenInside(Place_Type::HardwareStore, m_places.hardwareStores) ||
+		writeWhenInside(Place_Type::Morgue, m_places.morgues))
+	{
+		return;
+	}
+	if (place == &m_travelLocation)
+	{
+		write(Place_Type::Travel, 0U);
+		return;
+	}
+	write(Place_Type::Home, Snapshot::noIndex);
+}
+
+DiseaseSpreadSimulation::Place* DiseaseSpreadSimulation::Community::ReadPlace(BinaryReader& reader)
+{
+	const auto type = reader.ReadEnum(Place_Type::Travel);
+	switch (type)
+	{
+	case Place_Type::Home:
+		return PlaceAt(m_places.homes, reader.ReadIndex(m_places.homes.size()));
+	case Place_Type::Supply:
+		return PlaceAt(m_places.supplyStores, reader.ReadIndex(m_places.supplyStores.size()));
+	case Place_Type::Workplace:
+		return PlaceAt(m_places.workplaces, reader.ReadIndex(m_places.workplaces.size()));
+	case Place_Type::School:
+		return PlaceAt(m_places.schools, reader.ReadIndex(m_places.schools.size()));
+	case Place_Type::HardwareStore:
+		return PlaceAt(m_places.hardwareStores, reader.ReadIndex(m_places.hardwareStores.size()));
+	case Place_Type::Morgue:
+		return PlaceAt(m_places.morgues, reader.ReadIndex(m_places.morgues.size()));
+	case Place_Type::Travel:
+		if (reader.ReadIndex(1U) == Snapshot::noIndex)
+		{
+			return nullptr;
+		}
+		return &m_travelLocation;
+	default:
+		throw std::runtime_error("Snapshot contains an unknown place type!");
+	}
+}
+
 bool DiseaseSpreadSimulation::Community::TestPersonForInfection(const Person* person)
 {
 	if (!person->HasDisease())
@@ -336,10 +813,169 @@ bool DiseaseSpreadSimulation::Community::TestPersonForInfection(const Person* pe
 	return Random::Percent<float>() < person->GetDisease()->GetTestAccuracy();
 }
 
+void DiseaseSpreadSimulation::Community::PopulationChanged()
+{
+	m_populationStore.Assign(m_population);
+	m_updateScheduler.ScheduleEveryone();
+}
+
+void DiseaseSpreadSimulation::Community::PersonsAdded(size_t first)
+{
+	for (auto index = first; index < m_population.size(); index++)
+	{
+		m_populationStore.Append(m_population[index]);
+	}
+	m_updateScheduler.ScheduleEveryone();
+}
+
+void DiseaseSpreadSimulation::Community::PersonRemoved(uint32_t row)
+{
+	m_populationStore.Erase(row, m_population);
+	m_updateScheduler.ScheduleEveryone();
+}
+
 DiseaseSpreadSimulation::Place* DiseaseSpreadSimulation::Community::TransferToPlace(Person* person, Place* place)
 {
-	std::lock_guard<std::shared_mutex> lockTransferToPlace(placesMutex);
+	// Only the places themselves are changed, which lock their people on their own
+	if (m_deferTransfers)
+	{
+		return place;
+	}
+	PROFILE_ZONE("TransferToPlace");
+	std::shared_lock<std::shared_mutex> lockTransferToPlace(placesMutex);
 	person->GetWhereabouts()->RemovePerson(person);
 	place->AddPerson(person);
 	return place;
 }
+
+const DiseaseSpreadSimulation::PlaceTable& DiseaseSpreadSimulation::Community::GetPlaceTable() const
+{
+	return m_placeTable;
+}
+
+void DiseaseSpreadSimulation::Community::IndexPlaces()
+{
+	PreparePlaceTable();
+	IndexPlaces(0U, 1U);
+	FinishPlaceTable();
+}
+
+void DiseaseSpreadSimulation::Community::PreparePlaceTable()
+{
+	if (m_placeTable.Size() != m_places.Count())
+	{
+		m_placeTable.Layout(m_places);
+	}
+	m_placeTableOutgrown = false;
+}
+
+void DiseaseSpreadSimulation::Community::IndexPlaces(size_t chunk, size_t chunkCount)
+{
+	PROFILE_ZONE("IndexPlaces");
+	const auto placeCount = m_placeTable.Size();
+	m_places.ForEachPlace(placeCount * chunk / chunkCount, placeCount * (chunk + 1U) / chunkCount, [this](Place& place, size_t index)
+		{
+			// Everybody inside our places is part of our population and owns the row at its index
+			const auto& people = place.GetPeople();
+			const auto row = static_cast<uint32_t>(index);
+			if (!m_placeTable.Fits(row, people.size()))
+			{
+				m_placeTableOutgrown = true;
+				return;
+			}
+			auto occupants = m_placeTable.SetOccupantCount(row, people.size());
+			std::transform(people.begin(), people.end(), occupants.begin(), [](const Person* person)
+				{
+					return person->m_storeRow;
+				});
+		});
+}
+
+void DiseaseSpreadSimulation::Community::FinishPlaceTable()
+{
+	if (!m_placeTableOutgrown)
+	{
+		return;
+	}
+	// The new layout has room for everybody, so one pass is enough
+	m_placeTable.Layout(m_places);
+	m_placeTableOutgrown = false;
+	IndexPlaces(0U, 1U);
+}
+
+void DiseaseSpreadSimulation::Community::PlaceMoves::Group()
+{
+	std::sort(moves.begin(), moves.end(), [](const Move& lhs, const Move& rhs)
+		{
+			if (lhs.place != rhs.place)
+			{
+				return std::less<>{}(lhs.place, rhs.place);
+			}
+			return lhs.personID < rhs.personID;
+		});
+
+	groups.clear();
+	for (size_t begin = 0; begin < moves.size();)
+	{
+		auto end = begin + 1;
+		while (end < moves.size() && moves[end].place == moves[begin].place)
+		{
+			end++;
+		}
+		groups.emplace_back(begin, end);
+		begin = end;
+	}
+}
+
+template <typename Function>
+void DiseaseSpreadSimulation::Community::PlaceMoves::ForEachPlace(size_t chunk, size_t chunkCount, Function function) const
+{
+	const auto firstGroup = groups.size() * chunk / chunkCount;
+	const auto lastGroup = groups.size() * (chunk + 1U) / chunkCount;
+	for (auto group = firstGroup; group < lastGroup; group++)
+	{
+		const auto [begin, end] = groups[group];
+		if (moves[begin].place == nullptr)
+		{
+			continue;
+		}
+		for (auto index = begin; index < end; index++)
+		{
+			function(*moves[index].place, moves[index].person);
+		}
+	}
+}
+
+void DiseaseSpreadSimulation::Community::PrepareTransfers(const std::vector<Person*>& moving)
+{
+	PROFILE_ZONE("PrepareTransfers");
+	m_leaving.moves.clear();
+	m_arriving.moves.clear();
+	// Leave all places first, so every place only gets the persons that arrive
+	for (auto* person : moving)
+	{
+		m_leaving.moves.push_back({person->m_slotPlace, person->GetID(), person});
+		m_arriving.moves.push_back({person->whereabouts, person->GetID(), person});
+	}
+	m_leaving.Group();
+	m_arriving.Group();
+}
+
+void DiseaseSpreadSimulation::Community::LeavePlaces(size_t chunk, size_t chunkCount)
+{
+	PROFILE_ZONE("LeavePlaces");
+	m_leaving.ForEachPlace(chunk, chunkCount, [](Place& place, Person* person)
+		{
+			place.RemovePerson(person);
+		});
+}
+
+void DiseaseSpreadSimulation::Community::ArriveAtPlaces(size_t chunk, size_t chunkCount)
+{
+	PROFILE_ZONE("ArriveAtPlaces");
+	m_arriving.ForEachPlace(chunk, chunkCount, [](Place& place, Person* person)
+		{
+			place.AddPerson(person);
+		});
+}
+
@@ -1,21 +1,37 @@
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <optional>
+#include <memory>
+#include <utility>
 #include <vector>
 #include <algorithm>
 #include <random>
 #include <shared_mutex>
 #include "Disease/DiseaseContainment.h"
 #include "Places/Places.h"
+#include "Places/PlaceArena.h"
+#include "Places/PlaceTable.h"
+#include "Person/PopulationStore.h"
+#include "Simulation/UpdateScheduler.h"
+#include "Simulation/Snapshot.h"
+#include "Simulation/PopulationCache.h"
 
 namespace DiseaseSpreadSimulation
 {
 	class Person;
+	class Disease;
+	class ThreadPool;
 
 	class Community
 	{
 	public:
-		Community(const size_t populationSize, const Country country);
+		// The population is created in chunks on the pool or one chunk after another without one
+		Community(const size_t populationSize, const Country country, ThreadPool* pool = nullptr);
+		// Creates the places for the size of the cached population and its persons inside them
+		Community(const std::vector<CachedPerson>& population, const Country country);
+		// A copy is independent of the original. Its persons and places point into the copy at the same indices.
+		// Places and persons that don't belong to the original are kept as they are.
 		Community(const Community& other);
 		Community(Community&& other) noexcept;
 		Community& operator=(const Community& other);
@@ -38,12 +54,41 @@ namespace DiseaseSpreadSimulation
 		Place* TransferToMorgue(Person* person);
 		Place* TransferToTravelLocation(Person* person);
 
+		// While deferred the transfers only change the whereabouts of a person.
+		// The places are changed when the transfers are applied.
+		void DeferTransfers(bool defer);
+		// Move the persons at the indices into their whereabouts
+		void ApplyTransfers(const std::vector<uint32_t>& personIndices);
+		// Move every person into its whereabouts
+		void ApplyTransfers();
+		// The steps of ApplyTransfers for chunks on several threads. Prepare groups the moves by place, so every chunk only changes
+		// its own places. Every chunk has to leave before the first one arrives. The order of the people inside a place does not
+		// depend on the chunks.
+		void PrepareTransfers(const std::vector<uint32_t>& personIndices);
+		void PrepareTransfers();
+		void LeavePlaces(size_t chunk, size_t chunkCount);
+		void ArriveAtPlaces(size_t chunk, size_t chunkCount);
+
+		// Our places with their occupants as indices into the population. Only valid after the places were indexed.
+		const PlaceTable& GetPlaceTable() const;
+		// Write the current occupants of every place into the place table
+		void IndexPlaces();
+		// The steps of IndexPlaces for chunks on several threads. Prepare lays the table out when the places have changed.
+		// Finish lays it out again and indexes every place when a place has outgrown its range.
+		void PreparePlaceTable();
+		void IndexPlaces(size_t chunk, size_t chunkCount);
+		void FinishPlaceTable();
+
 		std::vector<Person>& GetPopulation();
 		const std::vector<Person>& GetPopulation() const;
+		PopulationStore& GetPopulationStore();
+		const PopulationStore& GetPopulationStore() const;
+		UpdateScheduler& GetUpdateScheduler();
 		Places& GetPlaces();
 		const Places& GetPlaces() const;
 		Travel& GetTravelLocation();
 		std::vector<Home>& GetHomes();
+		// The random places are read without a lock. Places are only added while the community is set up.
 		// Returns a random supply store
 		Supply* GetSupplyStore();
 		// Returns a random hardware store
@@ -68,17 +113,68 @@ namespace DiseaseSpreadSimulation
 		[[nodiscard]] size_t NumberOfPositiveTests() const;
 		[[nodiscard]] size_t NumberOfPersonsQuarantined() const;
 
+		// Persons are stored with their places as indices. Load replaces everything we had.
+		// A stored community takes at least its fixed values, its counts of places and persons and its travel location.
+		static constexpr size_t minSnapshotSize{8U * sizeof(uint32_t) + 4U * sizeof(bool) + 2U * sizeof(uint64_t) + Place::minSnapshotSize};
+		void Save(BinaryWriter& writer, const std::vector<Disease>& diseases) const;
+		void Load(BinaryReader& reader, const std::vector<Disease>& diseases);
+		// A place is stored as its type and index inside our places. Places that are not ours are stored as missing.
+		void WritePlace(BinaryWriter& writer, const Place* place) const;
+		Place* ReadPlace(BinaryReader& reader);
+		// The persons for the population cache. Only valid right after the community was created, while everyone is healthy at home.
+		[[nodiscard]] std::vector<CachedPerson> CachePopulation() const;
+
 	private:
 		static bool TestPersonForInfection(const Person* person);
+		// Call after the whole population was replaced. Gives every person a new row.
+		void PopulationChanged();
+		// Call after persons were added to the end of the population from the index on
+		void PersonsAdded(size_t first);
+		// Call after the person at the row was erased. Indices into the population after it have changed.
+		void PersonRemoved(uint32_t row);
 		Place* TransferToPlace(Person* person, Place* place);
+		struct Move
+		{
+			Place* place;
+			uint32_t personID;
+			Person* person;
+		};
+		// Moves sorted by place and id with the range of every place
+		struct PlaceMoves
+		{
+			std::vector<Move> moves{};
+			std::vector<std::pair<size_t, size_t>> groups{};
+
+			void Group();
+			template <typename Function>
+			void ForEachPlace(size_t chunk, size_t chunkCount, Function function) const;
+		};
+		void PrepareTransfers(const std::vector<Person*>& moving);
+		// Translate every pointer into the source to the same index inside our places and population
+		void RebindFrom(const Community& source);
+		Place* CorrespondingPlace(const Community& source, Place* place);
+		Person* CorrespondingPerson(const Community& source, Person* person);
+		// Persons keep a pointer to their community and travelers one to its travel location, which both change when the community is moved
+		void RebindCommunity(const Place* movedTravelLocation);
 
 	private:
-		const uint32_t m_id{0};
+		uint32_t m_id{0};
 		std::vector<Person> m_population{};
+		PopulationStore m_populationStore{};
+		UpdateScheduler m_updateScheduler{};
+		// Holds the people of our places and is destroyed after them. Copied communities use the default resource.
+		std::unique_ptr<PlaceArena> m_placeArena{};
 		Places m_places{};
 		Travel m_travelLocation;
 		DiseaseContainment m_containmentMeasures{};
 
+		bool m_deferTransfers{false};
+		// Only valid between PrepareTransfers and the last ArriveAtPlaces
+		PlaceMoves m_leaving{};
+		PlaceMoves m_arriving{};
+		// Indexed again every hour, but kept with its layout by copies
+		PlaceTable m_placeTable{};
+		std::atomic<bool> m_placeTableOutgrown{false};
 		size_t m_positiveTests{0};
 		size_t m_personsQuarantined{0};
 
@@ -0,0 +1,21 @@
+#include "Places/PlaceArena.h"
+
+DiseaseSpreadSimulation::PlaceArena::PlaceArena(size_t initialSize)
+	: m_buffer(initialSize)
+{
+}
+
+void* DiseaseSpreadSimulation::PlaceArena::do_allocate(size_t bytes, size_t alignment)
+{
+	std::lock_guard lockBuffer(m_mutex);
+	return m_buffer.allocate(bytes, alignment);
+}
+
+void DiseaseSpreadSimulation::PlaceArena::do_deallocate(void* /*pointer*/, size_t /*bytes*/, size_t /*alignment*/)
+{
+}
+
+bool DiseaseSpreadSimulation::PlaceArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
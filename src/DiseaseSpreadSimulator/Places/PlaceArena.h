@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+namespace DiseaseSpreadSimulation
+{
+	// Monotonic memory for the people inside the places of one community. Buffers of the places lie next to each other
+	// and are only given back when the arena is destroyed, so it has to outlive every place using it.
+	// Places of different threads grow at the same time, so allocations are locked. They are rare, because the places reserve their capacity up front.
+	class PlaceArena : public std::pmr::memory_resource
+	{
+	public:
+		explicit PlaceArena(size_t initialSize);
+		PlaceArena(const PlaceArena&) = delete;
+		PlaceArena(PlaceArena&&) = delete;
+		PlaceArena& operator=(const PlaceArena&) = delete;
+		PlaceArena& operator=(PlaceArena&&) = delete;
+		~PlaceArena() override = default;
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		// Memory is only released with the arena
+		void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		std::mutex m_mutex;
+		std::pmr::monotonic_buffer_resource m_buffer;
+	};
+} // namespace DiseaseSpreadSimulation
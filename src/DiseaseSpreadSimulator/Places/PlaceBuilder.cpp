@@ -11,7 +11,7 @@ namespace DiseaseSpreadSimulation::PlaceBuilder
 	constexpr float employeesStart{25.F};
 	constexpr float sizeInrease{50.F};
 
-	Places CreatePlaces(const size_t populationSize, const Country country)
+	Places CreatePlaces(const size_t populationSize, const Country country, std::pmr::memory_resource* peopleResource)
 	{
 		Places places;
 		// Return early with no locations when the population size is 0
@@ -25,10 +25,15 @@ namespace DiseaseSpreadSimulation::PlaceBuilder
 		auto homeCounts = GetHomeCounts(static_cast<float>(populationSize), country);
 		size_t sum = std::accumulate(homeCounts.begin(), homeCounts.end(), 0ULL);
 
+		// Homes are sorted by their member count like the populator expects. Members are assigned at random, so leave room for a few more.
+		static constexpr std::array<size_t, 4> homeCapacities{2U, 4U, 6U, 8U};
 		places.homes.reserve(sum);
-		for (size_t i = 0; i < sum; i++)
+		for (size_t category = 0; category < homeCounts.size(); category++)
 		{
-			places.homes.emplace_back();
+			for (size_t i = 0; i < homeCounts.at(category); i++)
+			{
+				places.homes.emplace_back(peopleResource).Reserve(homeCapacities.at(category));
+			}
 		}
 
 		// Create workplaces for people between 20 and 69
@@ -43,9 +48,25 @@ namespace DiseaseSpreadSimulation::PlaceBuilder
 		}
 
 		// Add the calculated amount of workplaces
+		places.workplaces.reserve(static_cast<size_t>(workplaceCount));
 		for (size_t i = 0; i < static_cast<size_t>(workplaceCount); i++)
 		{
-			places.workplaces.emplace_back();
+			places.workplaces.emplace_back(peopleResource);
+		}
+		// Reserve the employees of the size WorkplacesBySize will give the workplace. It takes them from the back.
+		auto workplaceIt = places.workplaces.rbegin();
+		for (size_t i = 0; i < Statistics::workplaceSizePercent.size(); i++)
+		{
+			const float employeesPerWorkplace{employeesStart + sizeInrease * static_cast<float>(i)};
+			const auto sizeCount = static_cast<size_t>((PersonPopulator::WorkingPeopleCountFloat(populationSize, country) * Statistics::workplaceSizePercent.at(i)) / employeesPerWorkplace);
+			for (size_t j = 0; j < sizeCount && workplaceIt != places.workplaces.rend(); j++, ++workplaceIt)
+			{
+				workplaceIt->Reserve(static_cast<size_t>(employeesPerWorkplace));
+			}
+		}
+		for (; workplaceIt != places.workplaces.rend(); ++workplaceIt)
+		{
+			workplaceIt->Reserve(static_cast<size_t>(employeesStart));
 		}
 
 		// Create one supply building and a morgue for every 5000 persons. At least one of each
@@ -57,9 +78,9 @@ namespace DiseaseSpreadSimulation::PlaceBuilder
 		}
 		for (size_t i = 0; i < supplyCount; i++)
 		{
-			places.supplyStores.emplace_back();
-			places.hardwareStores.emplace_back();
-			places.morgues.emplace_back();
+			places.supplyStores.emplace_back(peopleResource);
+			places.hardwareStores.emplace_back(peopleResource);
+			places.morgues.emplace_back(peopleResource);
 		}
 
 		// Create schools
@@ -81,9 +102,10 @@ namespace DiseaseSpreadSimulation::PlaceBuilder
 		{
 			schoolCount = static_cast<size_t>(std::ceil(static_cast<double>(schoolKidsCount) / static_cast<double>(schoolSize)));
 		}
+		places.schools.reserve(schoolCount);
 		for (size_t i = 0; i < schoolCount; i++)
 		{
-			places.schools.emplace_back();
+			places.schools.emplace_back(peopleResource).Reserve(schoolKidsCount / schoolCount);
 		}
 
 		return places;
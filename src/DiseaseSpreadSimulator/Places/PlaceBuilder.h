@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <memory_resource>
 #include <vector>
 #include "Places/Places.h"
 
@@ -9,7 +10,8 @@ namespace DiseaseSpreadSimulation
 
 	namespace PlaceBuilder
 	{
-		Places CreatePlaces(const size_t populationSize, const Country country);
+		// The people of the places are allocated from the resource. Places reserve room for the people they get from the populator.
+		Places CreatePlaces(const size_t populationSize, const Country country, std::pmr::memory_resource* peopleResource = std::pmr::get_default_resource());
 		std::array<std::vector<Workplace*>, 5> WorkplacesBySize(const size_t populationSize, const Country country, std::vector<Workplace*> workplaces);
 		std::array<size_t, 4> GetHomeCounts(const float populationSize, const Country country);
 	} // namespace PlaceBuilder
@@ -0,0 +1,45 @@
+#include "Places/PlaceTable.h"
+#include <algorithm>
+#include "Places/Places.h"
+
+void DiseaseSpreadSimulation::PlaceTable::Layout(const Places& places)
+{
+	m_rows.clear();
+	m_rows.reserve(places.Count());
+	uint32_t firstOccupant{0U};
+	places.ForEachPlace(0U, places.Count(), [this, &firstOccupant](const Place& place, size_t /*index*/)
+		{
+			const auto capacity = static_cast<uint32_t>(std::max(place.GetCapacity(), place.GetPersonCount()));
+			m_rows.push_back({place.GetType(), capacity, firstOccupant, 0U});
+			firstOccupant += capacity;
+		});
+	m_occupants.assign(firstOccupant, 0U);
+}
+
+size_t DiseaseSpreadSimulation::PlaceTable::Size() const
+{
+	return m_rows.size();
+}
+
+const DiseaseSpreadSimulation::PlaceTable::Row& DiseaseSpreadSimulation::PlaceTable::GetRow(uint32_t index) const
+{
+	return m_rows[index];
+}
+
+std::span<const uint32_t> DiseaseSpreadSimulation::PlaceTable::GetOccupants(uint32_t index) const
+{
+	const auto& row = m_rows[index];
+	return {m_occupants.data() + row.firstOccupant, row.occupantCount};
+}
+
+bool DiseaseSpreadSimulation::PlaceTable::Fits(uint32_t index, size_t count) const
+{
+	return count <= m_rows[index].capacity;
+}
+
+std::span<uint32_t> DiseaseSpreadSimulation::PlaceTable::SetOccupantCount(uint32_t index, size_t count)
+{
+	auto& row = m_rows[index];
+	row.occupantCount = static_cast<uint32_t>(count);
+	return {m_occupants.data() + row.firstOccupant, count};
+}
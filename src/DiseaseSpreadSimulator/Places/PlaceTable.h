@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace DiseaseSpreadSimulation
+{
+	struct Places;
+	enum class Place_Type : uint8_t;
+
+	// Flat table of the places of a community, addressed by the index of the place inside Places::ForEachPlace.
+	// Every row holds the type, the capacity and the range of the occupants, which are stored as indices into the population.
+	// There are no pointers inside, so a copy of the community or of its snapshot can take the table as it is.
+	class PlaceTable
+	{
+	public:
+		struct Row
+		{
+			Place_Type type;
+			uint32_t capacity;
+			uint32_t firstOccupant;
+			uint32_t occupantCount;
+		};
+
+		// Give every place a range for at least the people it has or has reserved room for. Drops the occupants.
+		void Layout(const Places& places);
+		[[nodiscard]] size_t Size() const;
+		[[nodiscard]] const Row& GetRow(uint32_t index) const;
+		[[nodiscard]] std::span<const uint32_t> GetOccupants(uint32_t index) const;
+		[[nodiscard]] bool Fits(uint32_t index, size_t count) const;
+		// The range for the count of occupants of the place, which has to fit. Rows of different places can be written at the same time.
+		[[nodiscard]] std::span<uint32_t> SetOccupantCount(uint32_t index, size_t count);
+
+	private:
+		std::vector<Row> m_rows{};
+		std::vector<uint32_t> m_occupants{};
+	};
+	static_assert(std::is_trivially_copyable_v<PlaceTable::Row>);
+} // namespace DiseaseSpreadSimulation
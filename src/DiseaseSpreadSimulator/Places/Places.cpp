@@ -1,4 +1,6 @@
 #include "Places/Places.h"
+#include <algorithm>
+#include <stdexcept>
 #include "Enums.h"
 #include "IDGenerator/IDGenerator.h"
 #include "Person/Person.h"
@@ -11,25 +13,88 @@ uint32_t DiseaseSpreadSimulation::Place::GetID() const
 void DiseaseSpreadSimulation::Place::AddPerson(Person* person)
 {
 	std::lock_guard<std::mutex> lockPeople(peopleMutex);
+	person->m_slotPlace = this;
+	person->m_placeSlot = static_cast<uint32_t>(people.size());
 	people.push_back(person);
 }
 
 void DiseaseSpreadSimulation::Place::RemovePerson(uint32_t id) // NOLINT(*-identifier-length)
 {
 	std::lock_guard<std::mutex> lockPeople(peopleMutex);
-	people.erase(
-		std::remove_if(people.begin(), people.end(), [&](Person* person)
-			{
-				return person->GetID() == id;
-			}),
-		people.end());
+	auto toRemove = std::find_if(people.begin(), people.end(), [&](const Person* person)
+		{
+			return person->GetID() == id;
+		});
+	if (toRemove != people.end())
+	{
+		RemoveAtSlot(static_cast<size_t>(std::distance(people.begin(), toRemove)));
+	}
 }
 
 void DiseaseSpreadSimulation::Place::RemovePerson(Person* person)
 {
+	{
+		std::lock_guard<std::mutex> lockPeople(peopleMutex);
+		// The slot is only valid when the person was added here last
+		if (person->m_placeSlot < people.size() && people[person->m_placeSlot] == person)
+		{
+			RemoveAtSlot(person->m_placeSlot);
+			return;
+		}
+	}
 	RemovePerson(person->GetID());
 }
 
+void DiseaseSpreadSimulation::Place::Reserve(size_t capacity)
+{
+	std::lock_guard<std::mutex> lockPeople(peopleMutex);
+	people.reserve(capacity);
+}
+
+void DiseaseSpreadSimulation::Place::RemoveAtSlot(size_t slot)
+{
+	if (people[slot]->m_slotPlace == this)
+	{
+		people[slot]->m_slotPlace = nullptr;
+	}
+	// Swap with the last person so nobody else has to be moved. The order of the people is not kept.
+	if (slot != people.size() - 1U)
+	{
+		people[slot] = people.back();
+		if (people[slot]->m_slotPlace == this)
+		{
+			people[slot]->m_placeSlot = static_cast<uint32_t>(slot);
+		}
+	}
+	people.pop_back();
+}
+
+void DiseaseSpreadSimulation::Place::Save(BinaryWriter& writer, const std::vector<Person>& population) const
+{
+	writer.Write(placeID);
+	writer.Write(static_cast<uint32_t>(people.size()));
+	for (const auto* person : people)
+	{
+		writer.Write(static_cast<uint32_t>(person - population.data()));
+	}
+}
+
+void DiseaseSpreadSimulation::Place::Load(BinaryReader& reader, std::vector<Person>& population)
+{
+	placeID = reader.Read<uint32_t>();
+	const auto count = reader.ReadCount(sizeof(uint32_t));
+	people.clear();
+	for (uint32_t i = 0U; i < count; i++)
+	{
+		const auto index = reader.ReadIndex(population.size());
+		if (index == Snapshot::noIndex)
+		{
+			throw std::runtime_error("Snapshot contains a place with a missing person!");
+		}
+		AddPerson(&population[index]);
+	}
+}
+
 std::string DiseaseSpreadSimulation::Place::TypeToString(Place_Type type)
 {
 	switch (type)
@@ -61,7 +126,7 @@ std::string DiseaseSpreadSimulation::Place::TypeToString(Place_Type type)
 	return {};
 }
 
-std::vector<DiseaseSpreadSimulation::Person*>& DiseaseSpreadSimulation::Place::GetPeople()
+std::pmr::vector<DiseaseSpreadSimulation::Person*>& DiseaseSpreadSimulation::Place::GetPeople()
 {
 	return people;
 }
@@ -71,8 +136,15 @@ size_t DiseaseSpreadSimulation::Place::GetPersonCount() const
 	return people.size();
 }
 
-DiseaseSpreadSimulation::Place::Place(uint32_t id) // NOLINT(*-identifier-length)
-	: placeID(id)
+size_t DiseaseSpreadSimulation::Place::GetCapacity() const
+{
+	return people.capacity();
+}
+
+DiseaseSpreadSimulation::Place::Place(uint32_t id, Place_Type type, std::pmr::memory_resource* peopleResource) // NOLINT(*-identifier-length)
+	: placeID(id),
+	  placeType(type),
+	  people(peopleResource)
 {
 }
 
@@ -80,6 +152,7 @@ DiseaseSpreadSimulation::Place::Place(uint32_t id) // NOLINT(*-identifier-length
 // cppcheck-suppress missingMemberCopy
 DiseaseSpreadSimulation::Place::Place(const Place& other)
 	: placeID(other.placeID),
+	  placeType(other.placeType),
 	  people(other.people)
 {
 }
@@ -88,6 +161,7 @@ DiseaseSpreadSimulation::Place::Place(const Place& other)
 // cppcheck-suppress missingMemberCopy
 DiseaseSpreadSimulation::Place::Place(Place&& other) noexcept
 	: placeID(other.placeID),
+	  placeType(other.placeType),
 	  people(std::move(other.people))
 {
 }
@@ -97,12 +171,15 @@ DiseaseSpreadSimulation::Place::Place(Place&& other) noexcept
 DiseaseSpreadSimulation::Place& DiseaseSpreadSimulation::Place::operator=(Place&& other) noexcept
 {
 	std::swap(placeID, other.placeID);
-	std::swap(people, other.people);
+	// Swapping people from different memory resources is not allowed. Moving between them copies the people.
+	auto otherPeople = std::move(other.people);
+	other.people = std::move(people);
+	people = std::move(otherPeople);
 	return *this;
 }
 
-DiseaseSpreadSimulation::Home::Home()
-	: Place(IDGenerator::IDGenerator<Home>::GetNextID())
+DiseaseSpreadSimulation::Home::Home(std::pmr::memory_resource* peopleResource)
+	: Place(IDGenerator::IDGenerator<Home>::GetNextID(), Place_Type::Home, peopleResource)
 {
 }
 
@@ -129,13 +206,8 @@ DiseaseSpreadSimulation::Home& DiseaseSpreadSimulation::Home::operator=(Home&& o
 	return *this;
 }
 
-DiseaseSpreadSimulation::Place_Type DiseaseSpreadSimulation::Home::GetType() const
-{
-	return Place_Type::Home;
-}
-
-DiseaseSpreadSimulation::Supply::Supply()
-	: Place(IDGenerator::IDGenerator<Supply>::GetNextID())
+DiseaseSpreadSimulation::Supply::Supply(std::pmr::memory_resource* peopleResource)
+	: Place(IDGenerator::IDGenerator<Supply>::GetNextID(), Place_Type::Supply, peopleResource)
 {
 }
 
@@ -160,13 +232,8 @@ DiseaseSpreadSimulation::Supply& DiseaseSpreadSimulation::Supply::operator=(Supp
 	return *this;
 }
 
-DiseaseSpreadSimulation::Place_Type DiseaseSpreadSimulation::Supply::GetType() const
-{
-	return Place_Type::Supply;
-}
-
-DiseaseSpreadSimulation::Workplace::Workplace()
-	: Place(IDGenerator::IDGenerator<Workplace>::GetNextID())
+DiseaseSpreadSimulation::Workplace::Workplace(std::pmr::memory_resource* peopleResource)
+	: Place(IDGenerator::IDGenerator<Workplace>::GetNextID(), Place_Type::Workplace, peopleResource)
 {
 }
 
@@ -191,13 +258,8 @@ DiseaseSpreadSimulation::Workplace& DiseaseSpreadSimulation::Workplace::operator
 	return *this;
 }
 
-DiseaseSpreadSimulation::Place_Type DiseaseSpreadSimulation::Workplace::GetType() const
-{
-	return Place_Type::Workplace;
-}
-
-DiseaseSpreadSimulation::HardwareStore::HardwareStore()
-	: Place(IDGenerator::IDGenerator<HardwareStore>::GetNextID())
+DiseaseSpreadSimulation::HardwareStore::HardwareStore(std::pmr::memory_resource* peopleResource)
+	: Place(IDGenerator::IDGenerator<HardwareStore>::GetNextID(), Place_Type::HardwareStore, peopleResource)
 {
 }
 
@@ -222,13 +284,8 @@ DiseaseSpreadSimulation::HardwareStore& DiseaseSpreadSimulation::HardwareStore::
 	return *this;
 }
 
-DiseaseSpreadSimulation::Place_Type DiseaseSpreadSimulation::HardwareStore::GetType() const
-{
-	return Place_Type::HardwareStore;
-}
-
-DiseaseSpreadSimulation::Morgue::Morgue()
-	: Place(IDGenerator::IDGenerator<Morgue>::GetNextID())
+DiseaseSpreadSimulation::Morgue::Morgue(std::pmr::memory_resource* peopleResource)
+	: Place(IDGenerator::IDGenerator<Morgue>::GetNextID(), Place_Type::Morgue, peopleResource)
 {
 }
 
@@ -253,13 +310,8 @@ DiseaseSpreadSimulation::Morgue& DiseaseSpreadSimulation::Morgue::operator=(Morg
 	return *this;
 }
 
-DiseaseSpreadSimulation::Place_Type DiseaseSpreadSimulation::Morgue::GetType() const
-{
-	return Place_Type::Morgue;
-}
-
-DiseaseSpreadSimulation::School::School()
-	: Place(IDGenerator::IDGenerator<School>::GetNextID())
+DiseaseSpreadSimulation::School::School(std::pmr::memory_resource* peopleResource)
+	: Place(IDGenerator::IDGenerator<School>::GetNextID(), Place_Type::School, peopleResource)
 {
 }
 
@@ -284,13 +336,8 @@ DiseaseSpreadSimulation::School& DiseaseSpreadSimulation::School::operator=(Scho
 	return *this;
 }
 
-DiseaseSpreadSimulation::Place_Type DiseaseSpreadSimulation::School::GetType() const
-{
-	return Place_Type::School;
-}
-
-DiseaseSpreadSimulation::Travel::Travel()
-	: Place(IDGenerator::IDGenerator<Travel>::GetNextID())
+DiseaseSpreadSimulation::Travel::Travel(std::pmr::memory_resource* peopleResource)
+	: Place(IDGenerator::IDGenerator<Travel>::GetNextID(), Place_Type::Travel, peopleResource)
 {
 }
 
@@ -316,11 +363,6 @@ DiseaseSpreadSimulation::Travel& DiseaseSpreadSimulation::Travel::operator=(Trav
 	return *this;
 }
 
-DiseaseSpreadSimulation::Place_Type DiseaseSpreadSimulation::Travel::GetType() const
-{
-	return Place_Type::Travel;
-}
-
 void DiseaseSpreadSimulation::Places::Insert(Places other)
 {
 	homes.reserve(homes.size() + other.homes.size());
@@ -341,3 +383,8 @@ void DiseaseSpreadSimulation::Places::Insert(Places other)
 	morgues.reserve(morgues.size() + other.morgues.size());
 	AppendVectorAtEnd(morgues, std::move(other.morgues));
 }
+
+size_t DiseaseSpreadSimulation::Places::Count() const
+{
+	return homes.size() + supplyStores.size() + workplaces.size() + schools.size() + hardwareStores.size();
+}
@@ -1,24 +1,36 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
+#include <memory_resource>
 #include <vector>
 #include <mutex>
+#include "Simulation/Snapshot.h"
 
 namespace DiseaseSpreadSimulation
 {
 	class Person;
-	enum class Place_Type;
+	enum class Place_Type : uint8_t;
 
 	class Place
 	{
 	public:
-		[[nodiscard]] virtual Place_Type GetType() const = 0;
-		std::vector<Person*>& GetPeople();
+		// Stored inside the place, so asking for the type is a plain load instead of a virtual call
+		[[nodiscard]] Place_Type GetType() const
+		{
+			return placeType;
+		}
+		std::pmr::vector<Person*>& GetPeople();
 		[[nodiscard]] size_t GetPersonCount() const;
+		// People that fit inside before adding them allocates
+		[[nodiscard]] size_t GetCapacity() const;
 		[[nodiscard]] uint32_t GetID() const;
 		// People inside the place are not owned by the place
 		void AddPerson(Person* person);
+		// Removing changes the order of the remaining people
 		void RemovePerson(uint32_t id);
 		void RemovePerson(Person* person);
+		// Make room for the people we expect at the same time, so adding them doesn't allocate
+		void Reserve(size_t capacity);
 
 		auto operator<=>(const Place& rhs) const
 		{
@@ -39,20 +51,32 @@ namespace DiseaseSpreadSimulation
 
 		static std::string TypeToString(Place_Type type);
 
-		virtual ~Place() = default;
+		// The people are stored as their indices inside the population
+		// A stored place takes at least its id and its count of people
+		static constexpr size_t minSnapshotSize{2U * sizeof(uint32_t)};
+		void Save(BinaryWriter& writer, const std::vector<Person>& population) const;
+		void Load(BinaryReader& reader, std::vector<Person>& population);
 
 	protected:
-		explicit Place(uint32_t id);
+		// The people are allocated from the resource, which has to outlive the place. Copies use the default resource.
+		Place(uint32_t id, Place_Type type, std::pmr::memory_resource* peopleResource);
 		Place(const Place& other);
 		Place(Place&& other) noexcept;
-		// Deleted here because a cast to abstract class is not allowed and we only need the derived versions
+		// Deleted here because we only need the derived versions. Assignment keeps the type.
 		Place& operator=(const Place& other) = delete;
 		Place& operator=(Place&& other) noexcept;
+		// Places are never destroyed through the base, so they don't need a vtable
+		~Place() = default;
+
+	private:
+		// Needs a lock on the people
+		void RemoveAtSlot(size_t slot);
 
 	protected:
 		uint32_t placeID{0};
+		const Place_Type placeType;
 		// People inside the place are not owned by the place
-		std::vector<Person*> people{};
+		std::pmr::vector<Person*> people;
 
 		std::mutex peopleMutex;
 	};
@@ -60,99 +84,119 @@ namespace DiseaseSpreadSimulation
 	class Home : public Place
 	{
 	public:
-		Home();
+		explicit Home(std::pmr::memory_resource* peopleResource = std::pmr::get_default_resource());
 		Home(const Home& other);
 		Home(Home&& other) noexcept;
 		Home& operator=(const Home& other);
 		Home& operator=(Home&& other) noexcept;
-		~Home() override = default;
-
-		[[nodiscard]] Place_Type GetType() const override;
+		~Home() = default;
 	};
 
 	class Supply : public Place
 	{
 	public:
-		Supply();
+		explicit Supply(std::pmr::memory_resource* peopleResource = std::pmr::get_default_resource());
 		Supply(const Supply& other);
 		Supply(Supply&& other) noexcept;
 		Supply& operator=(const Supply& other);
 		Supply& operator=(Supply&& other) noexcept;
-		~Supply() override = default;
-
-		[[nodiscard]] Place_Type GetType() const override;
+		~Supply() = default;
 	};
 
 	class Workplace : public Place
 	{
 	public:
-		Workplace();
+		explicit Workplace(std::pmr::memory_resource* peopleResource = std::pmr::get_default_resource());
 		Workplace(const Workplace& other);
 		Workplace(Workplace&& other) noexcept;
 		Workplace& operator=(const Workplace& other);
 		Workplace& operator=(Workplace&& other) noexcept;
-		~Workplace() override = default;
-
-		[[nodiscard]] Place_Type GetType() const override;
+		~Workplace() = default;
 	};
 
 	class School : public Place
 	{
 	public:
-		School();
+		explicit School(std::pmr::memory_resource* peopleResource = std::pmr::get_default_resource());
 		School(const School& other);
 		School(School&& other) noexcept;
 		School& operator=(const School& other);
 		School& operator=(School&& other) noexcept;
-		~School() override = default;
-
-		[[nodiscard]] Place_Type GetType() const override;
+		~School() = default;
 	};
 
 	class HardwareStore : public Place
 	{
 	public:
-		HardwareStore();
+		explicit HardwareStore(std::pmr::memory_resource* peopleResource = std::pmr::get_default_resource());
 		HardwareStore(const HardwareStore& other);
 		HardwareStore(HardwareStore&& other) noexcept;
 		HardwareStore& operator=(const HardwareStore& other);
 		HardwareStore& operator=(HardwareStore&& other) noexcept;
-		~HardwareStore() override = default;
-
-		[[nodiscard]] Place_Type GetType() const override;
+		~HardwareStore() = default;
 	};
 	class Morgue : public Place
 	{
 	public:
-		Morgue();
+		explicit Morgue(std::pmr::memory_resource* peopleResource = std::pmr::get_default_resource());
 		Morgue(const Morgue& other);
 		Morgue(Morgue&& other) noexcept;
 		Morgue& operator=(const Morgue& other);
 		Morgue& operator=(Morgue&& other) noexcept;
-		~Morgue() override = default;
-
-		[[nodiscard]] Place_Type GetType() const override;
+		~Morgue() = default;
 	private:
 	};
 
 	class Travel : public Place
 	{
 	public:
-		Travel();
+		explicit Travel(std::pmr::memory_resource* peopleResource = std::pmr::get_default_resource());
 		Travel(const Travel& other);
 		Travel(Travel&& other) noexcept;
 		Travel& operator=(const Travel& other);
 		Travel& operator=(Travel&& other) noexcept;
-		~Travel() override = default;
-
-		[[nodiscard]] Place_Type GetType() const override;
+		~Travel() = default;
 	};
 
 	struct Places
 	{
 		// Insert the other places at the end of each vector
 		void Insert(Places other);
+		// Homes, supply stores, workplaces, schools and hardware stores. Nobody meets anybody inside a morgue.
+		[[nodiscard]] size_t Count() const;
+		// Calls the function with the places from begin to end and their index, counted in the order of Count
+		template <typename Function>
+		void ForEachPlace(size_t begin, size_t end, Function function)
+		{
+			ForEachPlaceOf(*this, begin, end, function);
+		}
+		template <typename Function>
+		void ForEachPlace(size_t begin, size_t end, Function function) const
+		{
+			ForEachPlaceOf(*this, begin, end, function);
+		}
 	private:
+		template <typename Self, typename Function>
+		static void ForEachPlaceOf(Self& places, size_t begin, size_t end, Function& function)
+		{
+			size_t offset{0U};
+			const auto forPlacesOfType = [begin, end, &offset, &function](auto& placesOfType)
+			{
+				const auto first = std::max(begin, offset);
+				const auto last = std::min(end, offset + placesOfType.size());
+				for (auto placeIndex = first; placeIndex < last; placeIndex++)
+				{
+					function(placesOfType[placeIndex - offset], placeIndex);
+				}
+				offset += placesOfType.size();
+			};
+			forPlacesOfType(places.homes);
+			forPlacesOfType(places.supplyStores);
+			forPlacesOfType(places.workplaces);
+			forPlacesOfType(places.schools);
+			forPlacesOfType(places.hardwareStores);
+		}
+
 		template <typename T>
 		static void AppendVectorAtEnd(std::vector<T>& dest, std::vector<T>&& src)
 		{
@@ -1,13 +1,248 @@
 #pragma once
+#include <cstdint>
+#include <atomic>
+#include <bit>
+#include <limits>
 #include <vector>
 #include <concepts>
+#include <iterator>
 #include <random>
 #include <stdexcept>
 
 namespace Random
 {
-	static std::random_device seed;
-	static std::mt19937_64 generator(seed());
+	// Counter based SplitMix64 engine. Every call hashes the next value of a 64 bit counter.
+	// It is small enough to give every person its own stream and cheap to seed, copy and store.
+	class Engine
+	{
+	public:
+		using result_type = uint64_t;
+
+		constexpr explicit Engine(uint64_t seed = 0U)
+			: state(seed)
+		{
+		}
+
+		static constexpr result_type min()
+		{
+			return std::numeric_limits<result_type>::min();
+		}
+		static constexpr result_type max()
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		constexpr result_type operator()()
+		{
+			return Next(state);
+		}
+		// Advance the state and return its next number. Lets a batch of stored states be advanced side by side.
+		static constexpr result_type Next(uint64_t& engineState)
+		{
+			// Constants from https://prng.di.unimi.it/splitmix64.c
+			engineState += 0x9E3779B97F4A7C15ULL;
+			result_type z = engineState;
+			z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+			return z ^ (z >> 31U);
+		}
+
+		[[nodiscard]] constexpr uint64_t GetState() const
+		{
+			return state;
+		}
+		constexpr void SetState(uint64_t newState)
+		{
+			state = newState;
+		}
+
+		constexpr bool operator==(const Engine& rhs) const = default;
+
+	private:
+		uint64_t state;
+	};
+
+	// Derive the seed of an independent stream from a base seed
+	constexpr uint64_t StreamSeed(uint64_t seed, uint64_t streamID)
+	{
+		Engine mixer{seed ^ Engine{streamID}()};
+		return mixer();
+	}
+
+	// Map a random number to a double in [0, 1) from its upper 53 bits
+	constexpr double UnitDouble(uint64_t bits)
+	{
+		return static_cast<double>(bits >> 11U) * 0x1.0p-53;
+	}
+	// Same value as UnitDouble without a conversion from a 64 bit integer, which vector units without AVX-512 lack.
+	// Both halves of the 53 bits are placed into the mantissa of 2^52 and taken out again by subtracting it.
+	constexpr double LaneUnitDouble(uint64_t bits)
+	{
+		constexpr uint64_t exponent{0x4330000000000000ULL};
+		constexpr double offset{0x1.0p52};
+		const auto mantissa = bits >> 11U;
+		const auto high = std::bit_cast<double>(exponent | (mantissa >> 1U)) - offset;
+		const auto low = std::bit_cast<double>(exponent | (mantissa & 1U)) - offset;
+		return (high * 2. + low) * 0x1.0p-53;
+	}
+
+	namespace Detail
+	{
+		inline uint64_t NonDeterministicSeed()
+		{
+			std::random_device device;
+			return (static_cast<uint64_t>(device()) << 32U) ^ static_cast<uint64_t>(device());
+		}
+
+		inline std::atomic<uint64_t> globalSeed{NonDeterministicSeed()};
+		// Increased with every new seed to tell the threads to reseed their default stream
+		inline std::atomic<uint64_t> seedEpoch{0U};
+		inline std::atomic<uint64_t> nextThreadStream{0U};
+
+		struct ThreadStream
+		{
+			Engine engine{};
+			uint64_t epoch{std::numeric_limits<uint64_t>::max()};
+			// Stream set by a StreamGuard. Takes precedence over the default stream of the thread.
+			Engine* current{nullptr};
+		};
+		inline thread_local ThreadStream threadStream{};
+	} // namespace Detail
+
+	// Set the seed every default thread stream is derived from
+	inline void SetSeed(uint64_t seed)
+	{
+		Detail::globalSeed = seed;
+		Detail::nextThreadStream = 0U;
+		++Detail::seedEpoch;
+	}
+
+	inline uint64_t GetSeed()
+	{
+		return Detail::globalSeed;
+	}
+
+	// Returns the engine every random number of the calling thread is drawn from.
+	// This is the stream of the innermost StreamGuard or else the default stream of the thread.
+	inline Engine& Generator()
+	{
+		auto& threadStream = Detail::threadStream;
+		if (threadStream.current != nullptr)
+		{
+			return *threadStream.current;
+		}
+		if (const auto epoch = Detail::seedEpoch.load(std::memory_order_relaxed); threadStream.epoch != epoch)
+		{
+			threadStream.engine = Engine{StreamSeed(Detail::globalSeed, Detail::nextThreadStream++)};
+			threadStream.epoch = epoch;
+		}
+		return threadStream.engine;
+	}
+
+	// Draw every random number of the calling thread from the given engine while the guard lives
+	class StreamGuard
+	{
+	public:
+		explicit StreamGuard(Engine& engine)
+			: previous(Detail::threadStream.current)
+		{
+			Detail::threadStream.current = &engine;
+		}
+		~StreamGuard()
+		{
+			Detail::threadStream.current = previous;
+		}
+		StreamGuard(const StreamGuard&) = delete;
+		StreamGuard(StreamGuard&&) = delete;
+		StreamGuard& operator=(const StreamGuard&) = delete;
+		StreamGuard& operator=(StreamGuard&&) = delete;
+
+	private:
+		Engine* previous;
+	};
+
+	// Walker alias table built once from a list of weights. Every pick is an index weighted by them
+	// and takes constant time with one random number, no matter how many weights there are.
+	class AliasTable
+	{
+	public:
+		// Throws std::invalid_argument when there is no positive weight
+		template <typename Weights>
+		explicit AliasTable(const Weights& weights)
+		{
+			const auto count = static_cast<size_t>(std::distance(std::begin(weights), std::end(weights)));
+			double sum{0.0};
+			for (const auto& weight : weights)
+			{
+				if (static_cast<double>(weight) < 0.0)
+				{
+					throw std::invalid_argument("Weights can't be negative!");
+				}
+				sum += static_cast<double>(weight);
+			}
+			if (count == 0U || count > std::numeric_limits<uint32_t>::max() || !(sum > 0.0))
+			{
+				throw std::invalid_argument("The alias table needs at least one positive weight!");
+			}
+
+			// Scale the weights to an average of 1 and fill the columns below 1 with the excess of the ones above
+			std::vector<double> scaled{};
+			scaled.reserve(count);
+			for (const auto& weight : weights)
+			{
+				scaled.push_back(static_cast<double>(weight) * static_cast<double>(count) / sum);
+			}
+			m_threshold.assign(count, acceptAll);
+			m_alias.resize(count);
+			std::vector<uint32_t> small{};
+			std::vector<uint32_t> large{};
+			for (uint32_t index = 0U; index < count; index++)
+			{
+				m_alias.at(index) = index;
+				(scaled.at(index) < 1.0 ? small : large).push_back(index);
+			}
+			while (!small.empty() && !large.empty())
+			{
+				const auto less = small.back();
+				small.pop_back();
+				const auto more = large.back();
+				m_threshold.at(less) = static_cast<uint64_t>(scaled.at(less) * static_cast<double>(acceptAll));
+				m_alias.at(less) = more;
+				scaled.at(more) -= 1.0 - scaled.at(less);
+				if (scaled.at(more) < 1.0)
+				{
+					large.pop_back();
+					small.push_back(more);
+				}
+			}
+			// What is left is 1 up to rounding errors and keeps its column
+		}
+
+		// Pick an index from the engine
+		[[nodiscard]] size_t operator()(Engine& engine) const
+		{
+			const auto random = engine();
+			// The upper half chooses the column and the lower half if we take it or its alias
+			const auto column = ((random >> 32U) * m_threshold.size()) >> 32U;
+			return (random & 0xFFFFFFFFU) < m_threshold[column] ? column : m_alias[column];
+		}
+		// Pick an index from the stream of the calling thread
+		[[nodiscard]] size_t operator()() const
+		{
+			return (*this)(Generator());
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			return m_threshold.size();
+		}
+
+	private:
+		// The lower half of a random number below the threshold keeps the column
+		static constexpr uint64_t acceptAll{uint64_t{1U} << 32U};
+		std::vector<uint64_t> m_threshold{};
+		std::vector<uint32_t> m_alias{};
+	};
 
 	template <typename T>
 	static auto RandomVectorIndex(const std::vector<T>&  indexVector)
@@ -21,7 +256,7 @@ namespace Random
 		typedef typename std::vector<T>::size_type size_type;
 		std::uniform_int_distribution<size_type> distribution(static_cast<size_type>(0), indexVector.size() - static_cast<size_type>(1));
 
-		return distribution(generator);
+		return distribution(Generator());
 	};
 
 	template <std::integral T>
@@ -29,7 +264,7 @@ namespace Random
 	{
 		std::uniform_int_distribution<T> distribution(min, max);
 
-		return distribution(generator);
+		return distribution(Generator());
 	}
 
 	template <std::floating_point T>
@@ -37,7 +272,7 @@ namespace Random
 	{
 		std::uniform_real_distribution<T> distribution(min, max);
 
-		return distribution(generator);
+		return distribution(Generator());
 	}
 
 	// Return a random percentage between 0 and 1
@@ -0,0 +1,144 @@
+#include "Simulation/Ensemble.h"
+#include <array>
+#include <cmath>
+#include <optional>
+#include <utility>
+#include "fmt/core.h"
+#include "RandomNumbers.h"
+#include "Simulation/MeasureTime.h"
+
+DiseaseSpreadSimulation::Ensemble::Ensemble(uint64_t populationSize, std::string diseaseFilename, Country country, uint64_t seed, Contact_Model contactModel)
+	: m_populationSize(populationSize),
+	  m_diseaseFilename(std::move(diseaseFilename)),
+	  m_country(country),
+	  m_seed(seed),
+	  m_contactModel(contactModel)
+{
+}
+
+std::vector<DiseaseSpreadSimulation::Ensemble::ScenarioSummary> DiseaseSpreadSimulation::Ensemble::Run(uint32_t runDays, uint32_t numberOfRuns, ThreadPool& pool) const
+{
+	PROFILE_ZONE("Ensemble");
+	constexpr auto measureCount = containmentMeasures.size();
+
+	// One slot for every replica and measure. Every task only writes its own slot.
+	std::vector<Simulation::RunResult> results(numberOfRuns * measureCount);
+	// Every replica builds its population once and its measures start from copies of it
+	std::vector<std::optional<Community>> populations(numberOfRuns);
+	for (uint32_t replica = 0U; replica < numberOfRuns; replica++)
+	{
+		pool.Submit([this, runDays, replica, &pool, &populations, &results]()
+			{
+				Random::Engine stream{Random::StreamSeed(m_seed, replica)};
+				{
+					Random::StreamGuard streamGuard(stream);
+					populations[replica].emplace(m_populationSize, m_country, &pool);
+				}
+
+				// The simulations continue the stream after the build, like they had built the population themselves
+				const auto seed = stream.GetState();
+				for (size_t measure = 0; measure < measureCount; measure++)
+				{
+					pool.Submit([this, runDays, replica, measure, seed, &populations, &results]()
+						{
+							Simulation simulation{m_populationSize, false, m_diseaseFilename, m_country, seed, m_contactModel};
+							results[replica * measureCount + measure] = simulation.RunScenario(runDays, containmentMeasures.at(measure), &*populations[replica]);
+						});
+				}
+			});
+	}
+	pool.Wait();
+
+	std::vector<ScenarioSummary> summaries{};
+	summaries.reserve(measureCount);
+	for (size_t measure = 0; measure < measureCount; measure++)
+	{
+		std::array<std::vector<double>, 4> values{};
+		for (uint32_t replica = 0U; replica < numberOfRuns; replica++)
+		{
+			const auto& result = results[replica * measureCount + measure];
+			values[0].push_back(static_cast<double>(result.counts.everInfected));
+			values[1].push_back(static_cast<double>(result.counts.dead));
+			values[2].push_back(static_cast<double>(result.positiveTests));
+			values[3].push_back(static_cast<double>(result.personsQuarantined));
+		}
+		summaries.push_back({containmentMeasures.at(measure), numberOfRuns, EstimateMean(values[0]), EstimateMean(values[1]), EstimateMean(values[2]), EstimateMean(values[3])});
+	}
+	return summaries;
+}
+
+void DiseaseSpreadSimulation::Ensemble::PrintSummary(uint32_t runDays, const std::vector<ScenarioSummary>& summaries) const
+{
+	constexpr auto lineLength = 99U;
+	const auto toString = [](const Estimate& estimate)
+	{
+		return fmt::format("{:.1f} +- {:.1f}", estimate.mean, estimate.halfWidth);
+	};
+
+	fmt::print("{:-^{}}\n", "", lineLength);
+	fmt::print("Ensemble simulated {} days with {} persons and seed {}. Mean with 95% confidence interval of {} runs.\n", runDays, m_populationSize, m_seed, summaries.empty() ? 0U : summaries.front().replicas);
+	fmt::print("{:-^{}}\n", "", lineLength);
+	fmt::print("{:<16}{:>21}{:>20}{:>21}{:>21}\n", "Measures", "Total infections", "Deaths", "Positive tests", "Quarantined");
+	for (const auto& summary : summaries)
+	{
+		fmt::print("{:<16}{:>21}{:>20}{:>21}{:>21}\n", MeasureToString(summary.containmentMeasure), toString(summary.everInfected), toString(summary.dead), toString(summary.positiveTests), toString(summary.personsQuarantined));
+	}
+}
+
+DiseaseSpreadSimulation::Ensemble::Estimate DiseaseSpreadSimulation::Ensemble::EstimateMean(const std::vector<double>& values)
+{
+	if (values.empty())
+	{
+		return {};
+	}
+
+	const auto count = static_cast<double>(values.size());
+	double sum{0.};
+	for (const auto value : values)
+	{
+		sum += value;
+	}
+	const auto mean = sum / count;
+	if (values.size() < 2U)
+	{
+		return {mean, 0.};
+	}
+
+	double squaredDeviations{0.};
+	for (const auto value : values)
+	{
+		squaredDeviations += (value - mean) * (value - mean);
+	}
+	const auto standardError = std::sqrt(squaredDeviations / (count - 1.) / count);
+
+	// Two sided 97.5% quantiles of the t distribution for 1 to 30 degrees of freedom. Above that the normal distribution is close enough.
+	static constexpr std::array<double, 30> tQuantiles{
+		12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+		2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+		2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+	static constexpr double normalQuantile{1.96};
+	const auto degreesOfFreedom = values.size() - 1U;
+	const auto quantile = degreesOfFreedom <= tQuantiles.size() ? tQuantiles.at(degreesOfFreedom - 1U) : normalQuantile;
+
+	return {mean, quantile * standardError};
+}
+
+const char* DiseaseSpreadSimulation::Ensemble::MeasureToString(DiseaseContainmentMeasures containmentMeasure)
+{
+	// The measures add up, every one includes the ones before
+	switch (containmentMeasure)
+	{
+	case DiseaseContainmentMeasures::Nothing:
+		return "Nothing";
+	case DiseaseContainmentMeasures::MaskMandate:
+		return "Mask mandate";
+	case DiseaseContainmentMeasures::WorkingFromHome:
+		return "+ Home office";
+	case DiseaseContainmentMeasures::CloseShops:
+		return "+ Shops closed";
+	case DiseaseContainmentMeasures::Lockdown:
+		return "+ Lockdown";
+	default:
+		return "Unknown";
+	}
+}
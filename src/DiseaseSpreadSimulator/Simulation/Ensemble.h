@@ -0,0 +1,61 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Enums.h"
+#include "Simulation/Simulation.h"
+#include "Simulation/ThreadPool.h"
+
+namespace DiseaseSpreadSimulation
+{
+	// Runs independent replicas of every containment measure at the same time and aggregates their results.
+	// Every replica owns its simulation with its own random stream, so the result does not depend on the thread count.
+	class Ensemble
+	{
+	public:
+		Ensemble(uint64_t populationSize, std::string diseaseFilename, Country country, uint64_t seed, Contact_Model contactModel = Contact_Model::Aggregated);
+
+		// Mean over the replicas with the half width of its 95% confidence interval
+		struct Estimate
+		{
+			double mean{0.};
+			double halfWidth{0.};
+		};
+
+		struct ScenarioSummary
+		{
+			DiseaseContainmentMeasures containmentMeasure{DiseaseContainmentMeasures::Nothing};
+			size_t replicas{0U};
+			Estimate everInfected{};
+			Estimate dead{};
+			Estimate positiveTests{};
+			Estimate personsQuarantined{};
+		};
+
+		// Run every containment measure numberOfRuns times on the pool. The measures of a replica share its seed,
+		// so they are compared on the same population with the same first infection.
+		std::vector<ScenarioSummary> Run(uint32_t runDays, uint32_t numberOfRuns, ThreadPool& pool) const;
+		void PrintSummary(uint32_t runDays, const std::vector<ScenarioSummary>& summaries) const;
+
+		// Uses the student t distribution for small sample sizes
+		static Estimate EstimateMean(const std::vector<double>& values);
+
+		static constexpr std::array<DiseaseContainmentMeasures, 5> containmentMeasures{
+			DiseaseContainmentMeasures::Nothing,
+			DiseaseContainmentMeasures::MaskMandate,
+			DiseaseContainmentMeasures::WorkingFromHome,
+			DiseaseContainmentMeasures::CloseShops,
+			DiseaseContainmentMeasures::Lockdown};
+
+	private:
+		static const char* MeasureToString(DiseaseContainmentMeasures containmentMeasure);
+
+		const uint64_t m_populationSize{};
+		// The simulations keep a reference to it
+		const std::string m_diseaseFilename{};
+		const Country m_country{};
+		const uint64_t m_seed{};
+		const Contact_Model m_contactModel{Contact_Model::Aggregated};
+	};
+} // namespace DiseaseSpreadSimulation
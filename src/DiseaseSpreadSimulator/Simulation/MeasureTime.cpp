@@ -1,5 +1,11 @@
 #include "Simulation/MeasureTime.h"
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include "fmt/core.h"
+#include "nlohmann/json.hpp"
 
 Measure::MeasureTime::MeasureTime(std::string measureName)
 	: m_begin(std::chrono::high_resolution_clock::now()),
@@ -12,3 +18,201 @@ Measure::MeasureTime::~MeasureTime()
 	std::chrono::duration<double, std::milli> measurement = std::chrono::high_resolution_clock::now() - m_begin;
 	fmt::print("{} took: {}ms\n", m_measureName, measurement.count());
 }
+
+namespace
+{
+	using Clock = Measure::Profiler::Clock;
+
+	struct ZoneStats
+	{
+		uint64_t calls{0U};
+		Clock::duration total{};
+		Clock::duration min{Clock::duration::max()};
+		Clock::duration max{};
+	};
+
+	struct TraceEvent
+	{
+		uint32_t zone;
+		Clock::time_point begin;
+		Clock::duration duration;
+	};
+
+	// Owned by the registry as well, so the data survives the end of the thread
+	struct ThreadData
+	{
+		uint32_t threadID{0U};
+		std::vector<ZoneStats> zones{};
+		std::vector<TraceEvent> events{};
+		uint64_t droppedEvents{0U};
+	};
+
+	struct Registry
+	{
+		std::mutex mutex;
+		std::vector<std::string> zoneNames{};
+		std::vector<std::shared_ptr<ThreadData>> threads{};
+		Clock::time_point start{Clock::now()};
+	};
+
+	Registry& GetRegistry()
+	{
+		static Registry registry{};
+		return registry;
+	}
+
+	ThreadData& GetThreadData()
+	{
+		thread_local const std::shared_ptr<ThreadData> threadData = []()
+		{
+			auto data = std::make_shared<ThreadData>();
+			auto& registry = GetRegistry();
+			std::lock_guard lockRegistry(registry.mutex);
+			data->threadID = static_cast<uint32_t>(registry.threads.size());
+			registry.threads.push_back(data);
+			return data;
+		}();
+		return *threadData;
+	}
+} // namespace
+
+uint32_t Measure::Profiler::RegisterZone(const char* name)
+{
+	auto& registry = GetRegistry();
+	std::lock_guard lockRegistry(registry.mutex);
+	const auto zone = std::find(registry.zoneNames.begin(), registry.zoneNames.end(), name);
+	if (zone != registry.zoneNames.end())
+	{
+		return static_cast<uint32_t>(zone - registry.zoneNames.begin());
+	}
+	registry.zoneNames.emplace_back(name);
+	return static_cast<uint32_t>(registry.zoneNames.size() - 1U);
+}
+
+void Measure::Profiler::Record(uint32_t zone, Clock::time_point begin, Clock::time_point end)
+{
+	auto& threadData = GetThreadData();
+	if (zone >= threadData.zones.size())
+	{
+		threadData.zones.resize(zone + 1U);
+	}
+
+	const auto duration = end - begin;
+	auto& stats = threadData.zones[zone];
+	++stats.calls;
+	stats.total += duration;
+	stats.min = std::min(stats.min, duration);
+	stats.max = std::max(stats.max, duration);
+
+	if (threadData.events.size() < maxTraceEventsPerThread)
+	{
+		threadData.events.push_back({zone, begin, duration});
+	}
+	else
+	{
+		++threadData.droppedEvents;
+	}
+}
+
+std::vector<Measure::Profiler::ZoneSummary> Measure::Profiler::Summary()
+{
+	auto& registry = GetRegistry();
+	std::lock_guard lockRegistry(registry.mutex);
+
+	std::vector<ZoneSummary> summary(registry.zoneNames.size());
+	for (size_t zone = 0; zone < summary.size(); zone++)
+	{
+		summary[zone].name = registry.zoneNames[zone];
+	}
+	for (const auto& threadData : registry.threads)
+	{
+		for (size_t zone = 0; zone < threadData->zones.size(); zone++)
+		{
+			const auto& stats = threadData->zones[zone];
+			auto& zoneSummary = summary[zone];
+			zoneSummary.calls += stats.calls;
+			zoneSummary.total += stats.total;
+			zoneSummary.min = std::min(zoneSummary.min, stats.min);
+			zoneSummary.max = std::max(zoneSummary.max, stats.max);
+		}
+	}
+
+	summary.erase(std::remove_if(summary.begin(), summary.end(), [](const ZoneSummary& zoneSummary)
+					  {
+						  return zoneSummary.calls == 0U;
+					  }),
+		summary.end());
+	std::sort(summary.begin(), summary.end(), [](const ZoneSummary& lhs, const ZoneSummary& rhs)
+		{
+			return lhs.total > rhs.total;
+		});
+	return summary;
+}
+
+void Measure::Profiler::PrintSummary()
+{
+	using Milliseconds = std::chrono::duration<double, std::milli>;
+	using Microseconds = std::chrono::duration<double, std::micro>;
+
+	// Zones are nested, so the totals add up to more than the run time
+	fmt::print("{:<24}{:>14}{:>14}{:>14}{:>14}{:>14}\n", "Zone", "Calls", "Total ms", "Mean us", "Min us", "Max us");
+	for (const auto& zone : Summary())
+	{
+		const auto mean = Microseconds(zone.total).count() / static_cast<double>(zone.calls);
+		fmt::print("{:<24}{:>14}{:>14.2f}{:>14.2f}{:>14.2f}{:>14.2f}\n", zone.name, zone.calls, Milliseconds(zone.total).count(), mean, Microseconds(zone.min).count(), Microseconds(zone.max).count());
+	}
+}
+
+void Measure::Profiler::WriteChromeTrace(const std::string& filename)
+{
+	using Microseconds = std::chrono::duration<double, std::micro>;
+
+	std::ofstream file(filename);
+	if (!file)
+	{
+		throw std::runtime_error(fmt::format("Can't open {} to write the trace!", filename));
+	}
+
+	auto& registry = GetRegistry();
+	std::lock_guard lockRegistry(registry.mutex);
+
+	// Escape the names once
+	std::vector<std::string> names{};
+	names.reserve(registry.zoneNames.size());
+	for (const auto& name : registry.zoneNames)
+	{
+		names.push_back(nlohmann::json(name).dump());
+	}
+
+	file << "{\"traceEvents\":[";
+	bool first{true};
+	uint64_t droppedEvents{0U};
+	for (const auto& threadData : registry.threads)
+	{
+		droppedEvents += threadData->droppedEvents;
+		for (const auto& event : threadData->events)
+		{
+			file << fmt::format("{}\n{{\"name\":{},\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":0,\"tid\":{}}}",
+				first ? "" : ",",
+				names[event.zone],
+				Microseconds(event.begin - registry.start).count(),
+				Microseconds(event.duration).count(),
+				threadData->threadID);
+			first = false;
+		}
+	}
+	file << fmt::format("\n],\"displayTimeUnit\":\"ms\",\"otherData\":{{\"droppedEvents\":{}}}}}\n", droppedEvents);
+}
+
+void Measure::Profiler::Reset()
+{
+	auto& registry = GetRegistry();
+	std::lock_guard lockRegistry(registry.mutex);
+	for (auto& threadData : registry.threads)
+	{
+		threadData->zones.clear();
+		threadData->events.clear();
+		threadData->droppedEvents = 0U;
+	}
+	registry.start = Clock::now();
+}
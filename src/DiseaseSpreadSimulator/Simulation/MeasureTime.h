@@ -1,6 +1,8 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Measure
 {
@@ -13,4 +15,68 @@ namespace Measure
 		std::chrono::high_resolution_clock::time_point m_begin;
 		const std::string m_measureName;
 	};
+
+	// Collects the time spent inside named zones. Every thread adds to its own accumulators, so recording takes no lock.
+	// Use the PROFILE_ZONE macro, it is compiled out when ENABLE_PROFILING is not defined.
+	class Profiler
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct ZoneSummary
+		{
+			std::string name;
+			uint64_t calls{0U};
+			Clock::duration total{};
+			Clock::duration min{Clock::duration::max()};
+			Clock::duration max{};
+		};
+
+		// Zones with the same name share their id
+		static uint32_t RegisterZone(const char* name);
+		static void Record(uint32_t zone, Clock::time_point begin, Clock::time_point end);
+
+		// Only call these while no zone is measured. The accumulators of the threads are read without a lock.
+		// Zones summed over every thread and sorted by their total time
+		static std::vector<ZoneSummary> Summary();
+		static void PrintSummary();
+		// Every recorded zone as complete event. Open the file in chrome://tracing or https://ui.perfetto.dev
+		static void WriteChromeTrace(const std::string& filename);
+		static void Reset();
+
+		// Limits the memory of the trace. The summary contains every call.
+		static constexpr size_t maxTraceEventsPerThread{1'000'000U};
+	};
+
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(uint32_t zone)
+			: m_zone(zone),
+			  m_begin(Profiler::Clock::now())
+		{
+		}
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+		~ProfileScope()
+		{
+			Profiler::Record(m_zone, m_begin, Profiler::Clock::now());
+		}
+
+	private:
+		uint32_t m_zone;
+		Profiler::Clock::time_point m_begin;
+	};
 } // namespace Measure
+
+#define PROFILE_CONCAT_INNER(lhs, rhs) lhs##rhs
+#define PROFILE_CONCAT(lhs, rhs) PROFILE_CONCAT_INNER(lhs, rhs)
+
+// Measure the rest of the current scope
+#ifdef ENABLE_PROFILING
+#define PROFILE_ZONE(name)                                                                                     \
+	static const auto PROFILE_CONCAT(profileZone, __LINE__) = ::Measure::Profiler::RegisterZone(name); \
+	const ::Measure::ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileZone, __LINE__))
+#else
+#define PROFILE_ZONE(name)
+#endif
@@ -0,0 +1,168 @@
+#include "Simulation/Mobility.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "fmt/format.h"
+
+DiseaseSpreadSimulation::MobilityMatrix::MobilityMatrix(uint32_t communityCount)
+	: m_links(communityCount),
+	  m_destinations(communityCount)
+{
+}
+
+void DiseaseSpreadSimulation::MobilityMatrix::AddLink(uint32_t source, uint32_t destination, float weight)
+{
+	if (source >= CommunityCount() || destination >= CommunityCount())
+	{
+		throw std::out_of_range(fmt::format("The link {} -> {} connects a community outside of the {} communities!", source, destination, CommunityCount()));
+	}
+	if (!(weight > 0.F))
+	{
+		throw std::invalid_argument(fmt::format("The link {} -> {} needs a positive weight!", source, destination));
+	}
+
+	auto& links = m_links.at(source);
+	links.push_back({destination, weight});
+	std::vector<float> weights{};
+	weights.reserve(links.size());
+	for (const auto& link : links)
+	{
+		weights.push_back(link.weight);
+	}
+	m_destinations.at(source).emplace(weights);
+}
+
+DiseaseSpreadSimulation::MobilityMatrix DiseaseSpreadSimulation::MobilityMatrix::Ring(uint32_t communityCount)
+{
+	MobilityMatrix mobility{communityCount};
+	if (communityCount < 2U)
+	{
+		return mobility;
+	}
+	for (uint32_t source = 0U; source < communityCount; source++)
+	{
+		const auto next = (source + 1U) % communityCount;
+		const auto previous = (source + communityCount - 1U) % communityCount;
+		mobility.AddLink(source, next, 1.F);
+		// Two communities are each others only neighbor
+		if (previous != next)
+		{
+			mobility.AddLink(source, previous, 1.F);
+		}
+	}
+	return mobility;
+}
+
+DiseaseSpreadSimulation::MobilityMatrix DiseaseSpreadSimulation::MobilityMatrix::FromFile(const std::string& filename, uint32_t communityCount)
+{
+	std::ifstream file(filename);
+	if (!file)
+	{
+		throw std::runtime_error(fmt::format("Can't open the mobility file {}!", filename));
+	}
+
+	MobilityMatrix mobility{communityCount};
+	uint32_t lineNumber{0U};
+	for (std::string line; std::getline(file, line);)
+	{
+		lineNumber++;
+		if (line.empty() || line.front() == '#')
+		{
+			continue;
+		}
+
+		std::replace(line.begin(), line.end(), ',', ' ');
+		std::istringstream values(line);
+		uint32_t source{0U};
+		uint32_t destination{0U};
+		float weight{0.F};
+		if (!(values >> source >> destination >> weight))
+		{
+			throw std::runtime_error(fmt::format("Line {} of the mobility file {} is not \"source,destination,weight\"!", lineNumber, filename));
+		}
+		try
+		{
+			mobility.AddLink(source, destination, weight);
+		}
+		catch (const std::logic_error& error)
+		{
+			throw std::runtime_error(fmt::format("Line {} of the mobility file {}: {}", lineNumber, filename, error.what()));
+		}
+	}
+	return mobility;
+}
+
+uint32_t DiseaseSpreadSimulation::MobilityMatrix::CommunityCount() const
+{
+	return static_cast<uint32_t>(m_links.size());
+}
+
+const std::vector<DiseaseSpreadSimulation::MobilityMatrix::Link>& DiseaseSpreadSimulation::MobilityMatrix::Links(uint32_t source) const
+{
+	return m_links.at(source);
+}
+
+uint32_t DiseaseSpreadSimulation::MobilityMatrix::PickDestination(uint32_t source, Random::Engine& engine) const
+{
+	const auto& destinations = m_destinations.at(source);
+	if (!destinations)
+	{
+		return source;
+	}
+	return m_links[source][(*destinations)(engine)].destination;
+}
+
+DiseaseSpreadSimulation::TravelExchange::TravelExchange(const MobilityMatrix& mobility)
+	: m_outbound(mobility.CommunityCount()),
+	  m_inbound(mobility.CommunityCount())
+{
+	for (uint32_t source = 0U; source < mobility.CommunityCount(); source++)
+	{
+		auto& batches = m_outbound[source];
+		for (const auto& link : mobility.Links(source))
+		{
+			batches.push_back({link.destination, {}});
+		}
+		batches.push_back({source, {}});
+
+		for (uint32_t batch = 0U; batch < static_cast<uint32_t>(batches.size()); batch++)
+		{
+			m_inbound[batches[batch].destination].emplace_back(source, batch);
+		}
+	}
+}
+
+void DiseaseSpreadSimulation::TravelExchange::Clear(uint32_t source)
+{
+	for (auto& batch : m_outbound.at(source))
+	{
+		batch.visitors.clear();
+	}
+}
+
+void DiseaseSpreadSimulation::TravelExchange::Send(const Visitor& visitor)
+{
+	// Communities have only a few links, so searching them is cheaper than a lookup table
+	auto& batches = m_outbound.at(visitor.source);
+	const auto batch = std::find_if(batches.begin(), batches.end(), [&visitor](const auto& candidate)
+		{
+			return candidate.destination == visitor.destination;
+		});
+	if (batch == batches.end())
+	{
+		throw std::out_of_range(fmt::format("Community {} has no link to community {}!", visitor.source, visitor.destination));
+	}
+	batch->visitors.push_back(visitor);
+}
+
+std::vector<DiseaseSpreadSimulation::Visitor> DiseaseSpreadSimulation::TravelExchange::Arrivals(uint32_t destination) const
+{
+	std::vector<Visitor> arrivals{};
+	for (const auto& [source, batch] : m_inbound.at(destination))
+	{
+		const auto& visitors = m_outbound[source][batch].visitors;
+		arrivals.insert(arrivals.end(), visitors.begin(), visitors.end());
+	}
+	return arrivals;
+}
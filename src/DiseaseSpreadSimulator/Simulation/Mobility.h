@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "RandomNumbers.h"
+
+namespace DiseaseSpreadSimulation
+{
+	// Sparse links between communities. A traveler of a community visits one of its linked communities picked by the weights.
+	class MobilityMatrix
+	{
+	public:
+		struct Link
+		{
+			uint32_t destination{0U};
+			float weight{0.F};
+		};
+
+		explicit MobilityMatrix(uint32_t communityCount);
+
+		// Throws std::out_of_range for an unknown community and std::invalid_argument for a weight that is not positive
+		void AddLink(uint32_t source, uint32_t destination, float weight);
+
+		// Every community is linked to its two neighbors on a ring
+		static MobilityMatrix Ring(uint32_t communityCount);
+		// Reads one link per line as "source,destination,weight". Empty lines and lines starting with # are skipped.
+		// Throws std::runtime_error when the file can't be read.
+		static MobilityMatrix FromFile(const std::string& filename, uint32_t communityCount);
+
+		[[nodiscard]] uint32_t CommunityCount() const;
+		[[nodiscard]] const std::vector<Link>& Links(uint32_t source) const;
+		// A community without links keeps its travelers
+		[[nodiscard]] uint32_t PickDestination(uint32_t source, Random::Engine& engine) const;
+
+	private:
+		std::vector<std::vector<Link>> m_links{};
+		// Built with the first link of a community and rebuilt with every following one
+		std::vector<std::optional<Random::AliasTable>> m_destinations{};
+	};
+
+	// A traveler handed over to the community it visits. Carries everything its contacts need, so it can be sent to another process.
+	struct Visitor
+	{
+		uint64_t randomState{0U};
+		double susceptibility{0.};
+		// Communities are numbered by their index inside the mobility
+		uint32_t source{0U};
+		uint32_t destination{0U};
+		// Index inside the population of its community
+		uint32_t index{0U};
+		// Index of the disease when it has one
+		uint32_t disease{noDisease};
+		float spreadFactor{0.F};
+		bool isSusceptible{false};
+		bool isInfectious{false};
+		// Keeps the record free of padding, so every byte sent is defined
+		std::array<uint8_t, 2> reserved{};
+
+		static constexpr uint32_t noDisease{std::numeric_limits<uint32_t>::max()};
+	};
+	static_assert(sizeof(Visitor) == 40U, "Visitors are sent as they are");
+
+	// What happened to a visitor. Sent back to the community of the visitor.
+	struct VisitResult
+	{
+		uint64_t randomState{0U};
+		uint32_t source{0U};
+		uint32_t index{0U};
+		// Index of the disease the visitor got
+		uint32_t infectedBy{Visitor::noDisease};
+		// Residents the visitor has infected
+		uint32_t spreadCount{0U};
+	};
+	static_assert(sizeof(VisitResult) == 24U, "Visit results are sent as they are");
+
+	// Hands the travelers of every community over to their destinations once per hour.
+	// Every source only fills its own batches and the destinations only read them after every source is done,
+	// so the communities can be updated side by side without any lock.
+	class TravelExchange
+	{
+	public:
+		TravelExchange() = default;
+		explicit TravelExchange(const MobilityMatrix& mobility);
+
+		// Only called by the task of the source
+		void Clear(uint32_t source);
+		void Send(const Visitor& visitor);
+		// Every visitor sent to the destination, ordered by their source community
+		[[nodiscard]] std::vector<Visitor> Arrivals(uint32_t destination) const;
+
+	private:
+		struct Batch
+		{
+			uint32_t destination{0U};
+			std::vector<Visitor> visitors{};
+		};
+		// The batches of a source follow its links and end with the one for travelers staying inside
+		std::vector<std::vector<Batch>> m_outbound{};
+		// Source and batch index of everything sent to a destination ordered by source
+		std::vector<std::vector<std::pair<uint32_t, uint32_t>>> m_inbound{};
+	};
+} // namespace DiseaseSpreadSimulation
@@ -0,0 +1,80 @@
+#include "Simulation/OutputStage.h"
+#include <utility>
+
+DiseaseSpreadSimulation::OutputStage::OutputStage()
+	: m_worker(&OutputStage::WorkerLoop, this)
+{
+}
+
+DiseaseSpreadSimulation::OutputStage::~OutputStage()
+{
+	{
+		std::lock_guard lockJobs(m_mutex);
+		m_stop = true;
+	}
+	m_hasWork.notify_one();
+	m_worker.join();
+}
+
+void DiseaseSpreadSimulation::OutputStage::Submit(std::function<void()> job)
+{
+	{
+		std::lock_guard lockJobs(m_mutex);
+		m_jobs.push_back(std::move(job));
+	}
+	m_hasWork.notify_one();
+}
+
+void DiseaseSpreadSimulation::OutputStage::Flush()
+{
+	std::unique_lock lockJobs(m_mutex);
+	m_idle.wait(lockJobs, [this]()
+		{
+			return m_jobs.empty() && !m_working;
+		});
+	if (m_exception)
+	{
+		std::rethrow_exception(std::exchange(m_exception, nullptr));
+	}
+}
+
+void DiseaseSpreadSimulation::OutputStage::WorkerLoop()
+{
+	std::function<void()> job{};
+	while (true)
+	{
+		{
+			std::unique_lock lockJobs(m_mutex);
+			m_working = false;
+			if (m_jobs.empty())
+			{
+				m_idle.notify_all();
+			}
+			m_hasWork.wait(lockJobs, [this]()
+				{
+					return m_stop || !m_jobs.empty();
+				});
+			if (m_jobs.empty())
+			{
+				return;
+			}
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+			m_working = true;
+		}
+
+		try
+		{
+			job();
+		}
+		catch (...)
+		{
+			std::lock_guard lockJobs(m_mutex);
+			if (!m_exception)
+			{
+				m_exception = std::current_exception();
+			}
+		}
+	}
+}
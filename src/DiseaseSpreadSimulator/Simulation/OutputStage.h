@@ -0,0 +1,42 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace DiseaseSpreadSimulation
+{
+	// Formats and prints the output of the simulation on its own thread, so the next hour is computed meanwhile.
+	// Jobs run in the order they were submitted and should only use the snapshot they carry.
+	class OutputStage
+	{
+	public:
+		OutputStage();
+		OutputStage(const OutputStage&) = delete;
+		OutputStage(OutputStage&&) = delete;
+		OutputStage& operator=(const OutputStage&) = delete;
+		OutputStage& operator=(OutputStage&&) = delete;
+		// Runs the remaining jobs
+		~OutputStage();
+
+		void Submit(std::function<void()> job);
+		// Block until every submitted job is done and rethrow the first exception of a job.
+		// Has to be called before anything else is printed.
+		void Flush();
+
+	private:
+		void WorkerLoop();
+
+		std::mutex m_mutex;
+		std::condition_variable m_hasWork;
+		std::condition_variable m_idle;
+		std::deque<std::function<void()>> m_jobs{};
+		bool m_working{false};
+		bool m_stop{false};
+		std::exception_ptr m_exception{};
+		// Started last, after everything it uses
+		std::thread m_worker;
+	};
+} // namespace DiseaseSpreadSimulation
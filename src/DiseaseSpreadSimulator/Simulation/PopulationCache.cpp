@@ -0,0 +1,104 @@
+#include "Simulation/PopulationCache.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include "fmt/format.h"
+
+namespace
+{
+	// The byte of a one byte value. Copied out, because a bool or enum with another value can't be looked at directly.
+	template <typename T>
+	uint8_t ByteOf(const T& value)
+	{
+		static_assert(sizeof(T) == 1U, "Only one byte values");
+		uint8_t byte{0U};
+		std::memcpy(&byte, &value, sizeof(byte));
+		return byte;
+	}
+
+	bool IsValid(const DiseaseSpreadSimulation::CachedPerson& person)
+	{
+		return ByteOf(person.age) <= static_cast<uint8_t>(DiseaseSpreadSimulation::Age_Group::AboveEighty) &&
+			   ByteOf(person.sex) <= static_cast<uint8_t>(DiseaseSpreadSimulation::Sex::Male) &&
+			   ByteOf(person.canWorkFromHome) <= 1U &&
+			   ByteOf(person.hasCriticalInfrastructureJob) <= 1U;
+	}
+} // namespace
+
+DiseaseSpreadSimulation::PopulationCache::PopulationCache(std::filesystem::path directory)
+	: m_directory(std::move(directory))
+{
+}
+
+std::optional<std::vector<DiseaseSpreadSimulation::CachedPerson>> DiseaseSpreadSimulation::PopulationCache::Find(uint64_t populationSize, Country country, uint64_t seed) const
+{
+	const auto filename = Filename(populationSize, country, seed);
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		return std::nullopt;
+	}
+
+	Header header{};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header)); // NOLINT(*-reinterpret-cast)
+	if (!file || header.magic != magic || header.version != version)
+	{
+		return std::nullopt;
+	}
+	if (header.populationSize != populationSize || header.country != static_cast<uint32_t>(country) || header.seed != seed || header.personCount != populationSize)
+	{
+		throw std::runtime_error(fmt::format("The population cache {} was written for another population!", filename.string()));
+	}
+	// Check the size first, so a broken count can't make us allocate everything
+	std::error_code error{};
+	if (std::filesystem::file_size(filename, error) != sizeof(Header) + header.personCount * sizeof(CachedPerson) || error)
+	{
+		throw std::runtime_error(fmt::format("The population cache {} has the wrong size!", filename.string()));
+	}
+
+	std::vector<CachedPerson> population(header.personCount);
+	file.read(reinterpret_cast<char*>(population.data()), static_cast<std::streamsize>(population.size() * sizeof(CachedPerson))); // NOLINT(*-reinterpret-cast)
+	if (!file)
+	{
+		throw std::runtime_error(fmt::format("Failed to read the population cache {}!", filename.string()));
+	}
+	if (!std::all_of(population.begin(), population.end(), IsValid))
+	{
+		throw std::runtime_error(fmt::format("The population cache {} contains a broken person!", filename.string()));
+	}
+	return population;
+}
+
+void DiseaseSpreadSimulation::PopulationCache::Store(const std::vector<CachedPerson>& population, uint64_t populationSize, Country country, uint64_t seed) const
+{
+	std::error_code error{};
+	std::filesystem::create_directories(m_directory, error);
+	const auto filename = Filename(populationSize, country, seed);
+	// Write next to the file and replace it at the end, so other processes never read a half written population
+	auto temporaryFilename = filename;
+	temporaryFilename += fmt::format(".{}", std::random_device{}());
+	{
+		std::ofstream file(temporaryFilename, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			throw std::runtime_error(fmt::format("Can't open {} to store the population!", temporaryFilename.string()));
+		}
+		const Header header{magic, version, populationSize, seed, static_cast<uint32_t>(country), static_cast<uint32_t>(population.size())};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));                                                                     // NOLINT(*-reinterpret-cast)
+		file.write(reinterpret_cast<const char*>(population.data()), static_cast<std::streamsize>(population.size() * sizeof(CachedPerson))); // NOLINT(*-reinterpret-cast)
+		if (!file)
+		{
+			throw std::runtime_error(fmt::format("Failed to store the population into {}!", temporaryFilename.string()));
+		}
+	}
+	std::filesystem::rename(temporaryFilename, filename);
+}
+
+std::filesystem::path DiseaseSpreadSimulation::PopulationCache::Filename(uint64_t populationSize, Country country, uint64_t seed) const
+{
+	return m_directory / fmt::format("population_{}_{}_{}.bin", populationSize, static_cast<uint32_t>(country), seed);
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Enums.h"
+
+namespace DiseaseSpreadSimulation
+{
+	// A freshly created person. The places are stored as indices into the places of the community.
+	struct CachedPerson
+	{
+		uint64_t randomState{0U};
+		uint32_t id{0U};
+		uint32_t home{0U};
+		uint32_t workplace{0U};
+		uint32_t school{0U};
+		uint32_t foodBuyInterval{0U};
+		uint32_t hardwareBuyInterval{0U};
+		float acceptanceFactor{0.F};
+		float travelNeed{0.F};
+		Age_Group age{Age_Group::UnderTen};
+		Sex sex{Sex::Male};
+		bool canWorkFromHome{false};
+		bool hasCriticalInfrastructureJob{false};
+		// Keeps the record free of padding, so every byte of the file is defined
+		std::array<uint8_t, 4> reserved{};
+	};
+	static_assert(sizeof(CachedPerson) == 48U, "The cached person is stored as it is");
+
+	// Populations stored as files inside a directory, so they only have to be created once.
+	// A file is keyed by population size, country and seed. It is a fixed header followed by one CachedPerson per person,
+	// stored in the byte order of the machine, so the persons can be read in one block or mapped directly.
+	class PopulationCache
+	{
+	public:
+		// The directory is created when a population is stored
+		explicit PopulationCache(std::filesystem::path directory);
+
+		// Empty when there is no file for the key or it was written by another version.
+		// Throws std::runtime_error when the file is broken, also when a person has an age, sex or flag that can't be valid.
+		[[nodiscard]] std::optional<std::vector<CachedPerson>> Find(uint64_t populationSize, Country country, uint64_t seed) const;
+		// Replaces the file of the key. Throws std::runtime_error when it can't be written.
+		void Store(const std::vector<CachedPerson>& population, uint64_t populationSize, Country country, uint64_t seed) const;
+
+		[[nodiscard]] std::filesystem::path Filename(uint64_t populationSize, Country country, uint64_t seed) const;
+
+		// "DSPC" in little endian
+		static constexpr uint32_t magic{0x43505344U};
+		// Increase when the layout changes. Older files are created again.
+		static constexpr uint32_t version{1U};
+
+	private:
+		struct Header
+		{
+			uint32_t magic{0U};
+			uint32_t version{0U};
+			uint64_t populationSize{0U};
+			uint64_t seed{0U};
+			uint32_t country{0U};
+			uint32_t personCount{0U};
+		};
+		static_assert(sizeof(Header) % alignof(CachedPerson) == 0U, "The persons follow the header aligned");
+
+		std::filesystem::path m_directory;
+	};
+} // namespace DiseaseSpreadSimulation
@@ -0,0 +1,377 @@
+#include "Simulation/ProcessGroup.h"
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "fmt/format.h"
+
+namespace
+{
+	std::system_error LastError(const char* what)
+	{
+		return {errno, std::generic_category(), what};
+	}
+
+	// The call found the socket not ready or was interrupted and can be tried again
+	bool IsRetryable(int error)
+	{
+#if EAGAIN != EWOULDBLOCK
+		if (error == EWOULDBLOCK)
+		{
+			return true;
+		}
+#endif
+		return error == EAGAIN || error == EINTR;
+	}
+
+	// Sockets between every pair of ranks. The socket of rank i to rank j is at [i][j].
+	std::vector<std::vector<int>> ConnectEveryRank(uint32_t processCount)
+	{
+		std::vector<std::vector<int>> sockets(processCount, std::vector<int>(processCount, -1));
+		for (uint32_t first = 0U; first < processCount; first++)
+		{
+			for (uint32_t second = first + 1U; second < processCount; second++)
+			{
+				std::array<int, 2> pair{};
+				if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, pair.data()) != 0)
+				{
+					const auto error = LastError("socketpair");
+					for (const auto& row : sockets)
+					{
+						for (const auto socket : row)
+						{
+							if (socket >= 0)
+							{
+								::close(socket);
+							}
+						}
+					}
+					throw error;
+				}
+				sockets[first][second] = pair[0];
+				sockets[second][first] = pair[1];
+			}
+		}
+		return sockets;
+	}
+
+	// Close every socket except the ones of the rank
+	void CloseOtherRanks(std::vector<std::vector<int>>& sockets, uint32_t rank)
+	{
+		for (uint32_t other = 0U; other < sockets.size(); other++)
+		{
+			if (other == rank)
+			{
+				continue;
+			}
+			for (auto& socket : sockets[other])
+			{
+				if (socket >= 0)
+				{
+					::close(socket);
+					socket = -1;
+				}
+			}
+		}
+	}
+
+	// One message in each direction between us and another rank. The messages start with their size.
+	struct Channel
+	{
+		int socket{-1};
+		uint32_t peer{0U};
+		DiseaseSpreadSimulation::ProcessGroup::Message outgoing{};
+		size_t sent{0U};
+		std::array<std::byte, sizeof(uint64_t)> header{};
+		size_t headerReceived{0U};
+		size_t payloadReceived{0U};
+
+		[[nodiscard]] bool IsSent() const
+		{
+			return sent == outgoing.size();
+		}
+		[[nodiscard]] bool IsReceived(const DiseaseSpreadSimulation::ProcessGroup::Message& incoming) const
+		{
+			return headerReceived == header.size() && payloadReceived == incoming.size();
+		}
+
+		void Send()
+		{
+			const auto count = ::send(socket, outgoing.data() + sent, outgoing.size() - sent, MSG_NOSIGNAL);
+			if (count < 0)
+			{
+				if (IsRetryable(errno))
+				{
+					return;
+				}
+				throw LastError("send");
+			}
+			sent += static_cast<size_t>(count);
+		}
+
+		void Receive(DiseaseSpreadSimulation::ProcessGroup::Message& incoming)
+		{
+			const auto isHeader = headerReceived < header.size();
+			auto* const target = isHeader ? header.data() + headerReceived : incoming.data() + payloadReceived;
+			const auto wanted = isHeader ? header.size() - headerReceived : incoming.size() - payloadReceived;
+			const auto count = ::recv(socket, target, wanted, 0);
+			if (count == 0)
+			{
+				throw std::runtime_error(fmt::format("Rank {} has left the process group!", peer));
+			}
+			if (count < 0)
+			{
+				if (IsRetryable(errno))
+				{
+					return;
+				}
+				throw LastError("recv");
+			}
+
+			if (!isHeader)
+			{
+				payloadReceived += static_cast<size_t>(count);
+				return;
+			}
+			headerReceived += static_cast<size_t>(count);
+			if (headerReceived == header.size())
+			{
+				uint64_t size{0U};
+				std::memcpy(&size, header.data(), sizeof(size));
+				incoming.resize(size);
+			}
+		}
+	};
+} // namespace
+
+DiseaseSpreadSimulation::ProcessGroup DiseaseSpreadSimulation::ProcessGroup::Fork(uint32_t processCount)
+{
+	if (processCount == 0U)
+	{
+		throw std::invalid_argument("A process group needs at least one process!");
+	}
+	auto sockets = ConnectEveryRank(processCount);
+
+	std::vector<pid_t> children{};
+	for (uint32_t rank = 1U; rank < processCount; rank++)
+	{
+		const auto pid = ::fork();
+		if (pid == 0)
+		{
+			CloseOtherRanks(sockets, rank);
+			return {rank, std::move(sockets[rank])};
+		}
+		if (pid < 0)
+		{
+			// The children that are already running leave when they see our sockets close
+			const auto error = LastError("fork");
+			CloseOtherRanks(sockets, processCount);
+			for (const auto child : children)
+			{
+				::waitpid(child, nullptr, 0);
+			}
+			throw error;
+		}
+		children.push_back(pid);
+	}
+
+	CloseOtherRanks(sockets, 0U);
+	ProcessGroup group{0U, std::move(sockets[0])};
+	group.m_children = std::move(children);
+	return group;
+}
+
+std::vector<DiseaseSpreadSimulation::ProcessGroup> DiseaseSpreadSimulation::ProcessGroup::Connect(uint32_t processCount)
+{
+	auto sockets = ConnectEveryRank(processCount);
+	std::vector<ProcessGroup> groups{};
+	groups.reserve(processCount);
+	for (uint32_t rank = 0U; rank < processCount; rank++)
+	{
+		groups.push_back({rank, std::move(sockets[rank])});
+	}
+	return groups;
+}
+
+DiseaseSpreadSimulation::ProcessGroup::ProcessGroup(uint32_t rank, std::vector<int> sockets)
+	: m_rank(rank),
+	  m_sockets(std::move(sockets))
+{
+}
+
+DiseaseSpreadSimulation::ProcessGroup::ProcessGroup(ProcessGroup&& other) noexcept
+	: m_rank(other.m_rank),
+	  m_sockets(std::move(other.m_sockets)),
+	  m_children(std::move(other.m_children))
+{
+	other.m_sockets.clear();
+	other.m_children.clear();
+}
+
+DiseaseSpreadSimulation::ProcessGroup& DiseaseSpreadSimulation::ProcessGroup::operator=(ProcessGroup&& other) noexcept
+{
+	if (this != &other)
+	{
+		CloseAndReport();
+		m_rank = other.m_rank;
+		m_sockets = std::move(other.m_sockets);
+		m_children = std::move(other.m_children);
+		other.m_sockets.clear();
+		other.m_children.clear();
+	}
+	return *this;
+}
+
+DiseaseSpreadSimulation::ProcessGroup::~ProcessGroup()
+{
+	CloseAndReport();
+}
+
+void DiseaseSpreadSimulation::ProcessGroup::Close()
+{
+	// Closing first lets children that still wait for us leave
+	for (auto& socket : m_sockets)
+	{
+		if (socket >= 0)
+		{
+			::close(socket);
+			socket = -1;
+		}
+	}
+
+	std::string failures{};
+	for (const auto child : m_children)
+	{
+		int status{0};
+		pid_t waited{0};
+		while ((waited = ::waitpid(child, &status, 0)) < 0 && errno == EINTR)
+		{
+		}
+		if (waited < 0)
+		{
+			failures += fmt::format(" Process {} can't be waited for.", child);
+		}
+		else if (WIFSIGNALED(status))
+		{
+			failures += fmt::format(" Process {} was killed by signal {}.", child, WTERMSIG(status));
+		}
+		else if (WIFEXITED(status) && WEXITSTATUS(status) != 0)
+		{
+			failures += fmt::format(" Process {} exited with {}.", child, WEXITSTATUS(status));
+		}
+	}
+	m_children.clear();
+	if (!failures.empty())
+	{
+		throw std::runtime_error(fmt::format("A process of the group has failed!{}", failures));
+	}
+}
+
+void DiseaseSpreadSimulation::ProcessGroup::CloseAndReport() noexcept
+{
+	try
+	{
+		Close();
+	}
+	catch (const std::exception& error)
+	{
+		fmt::print(stderr, "{}\n", error.what());
+	}
+}
+
+uint32_t DiseaseSpreadSimulation::ProcessGroup::Rank() const
+{
+	return m_rank;
+}
+
+uint32_t DiseaseSpreadSimulation::ProcessGroup::Size() const
+{
+	return static_cast<uint32_t>(m_sockets.size());
+}
+
+std::vector<DiseaseSpreadSimulation::ProcessGroup::Message> DiseaseSpreadSimulation::ProcessGroup::Exchange(std::vector<Message> messages)
+{
+	if (messages.size() != m_sockets.size())
+	{
+		throw std::invalid_argument(fmt::format("Got {} messages for {} ranks!", messages.size(), m_sockets.size()));
+	}
+
+	std::vector<Message> received(messages.size());
+	received[m_rank] = std::move(messages[m_rank]);
+	std::vector<Channel> channels{};
+	channels.reserve(messages.size());
+	for (uint32_t peer = 0U; peer < Size(); peer++)
+	{
+		if (peer == m_rank)
+		{
+			continue;
+		}
+		const uint64_t size{messages[peer].size()};
+		std::array<std::byte, sizeof(size)> header{};
+		std::memcpy(header.data(), &size, sizeof(size));
+		Message framed{};
+		framed.reserve(header.size() + messages[peer].size());
+		framed.insert(framed.end(), header.begin(), header.end());
+		framed.insert(framed.end(), messages[peer].begin(), messages[peer].end());
+		channels.push_back({m_sockets[peer], peer, std::move(framed)});
+	}
+
+	// Send and receive at the same time, so no rank waits on a full socket of another one
+	std::vector<pollfd> polls{};
+	std::vector<Channel*> polled{};
+	while (true)
+	{
+		polls.clear();
+		polled.clear();
+		for (auto& channel : channels)
+		{
+			short events{0};
+			if (!channel.IsSent())
+			{
+				events |= POLLOUT;
+			}
+			if (!channel.IsReceived(received[channel.peer]))
+			{
+				events |= POLLIN;
+			}
+			if (events != 0)
+			{
+				polls.push_back({channel.socket, events, 0});
+				polled.push_back(&channel);
+			}
+		}
+		if (polls.empty())
+		{
+			break;
+		}
+
+		if (::poll(polls.data(), polls.size(), -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			throw LastError("poll");
+		}
+		for (size_t i = 0; i < polls.size(); i++)
+		{
+			auto& channel = *polled[i];
+			const auto events = polls[i].revents;
+			if ((events & POLLOUT) != 0 && !channel.IsSent())
+			{
+				channel.Send();
+			}
+			if ((events & (POLLIN | POLLHUP | POLLERR)) != 0 && !channel.IsReceived(received[channel.peer]))
+			{
+				channel.Receive(received[channel.peer]);
+			}
+		}
+	}
+	return received;
+}
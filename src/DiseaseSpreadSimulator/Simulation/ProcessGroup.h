@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
+
+namespace DiseaseSpreadSimulation
+{
+	// Processes on one host that are connected to each other by Unix socket pairs. Every process has its rank.
+	// The ranks only talk through Exchange, which all of them have to call in the same order.
+	// Not available on Windows, where Fork and Connect throw std::runtime_error.
+	class ProcessGroup
+	{
+	public:
+		using Message = std::vector<std::byte>;
+
+		// Start processCount - 1 child processes that continue from the call with their own rank. The caller keeps rank 0
+		// and waits for the children when its group is destroyed. Should be called before any thread is started.
+		// Throws std::system_error when a process or socket can't be created.
+		static ProcessGroup Fork(uint32_t processCount);
+		// Every rank inside this process, connected by the same sockets. Every rank has to be used by its own thread.
+		static std::vector<ProcessGroup> Connect(uint32_t processCount);
+
+		ProcessGroup(const ProcessGroup&) = delete;
+		ProcessGroup(ProcessGroup&& other) noexcept;
+		ProcessGroup& operator=(const ProcessGroup&) = delete;
+		ProcessGroup& operator=(ProcessGroup&& other) noexcept;
+		~ProcessGroup();
+
+		// Close the sockets and wait for the children. Throws std::runtime_error when a child has exited with an error or was killed.
+		// Called by the destructor, which only prints the failure.
+		void Close();
+
+		[[nodiscard]] uint32_t Rank() const;
+		[[nodiscard]] uint32_t Size() const;
+
+		// Send one message to every rank and receive one from every rank, indexed by rank. Our own message is kept as it is.
+		// Throws std::runtime_error when another rank has left the group and std::system_error when a socket fails.
+		std::vector<Message> Exchange(std::vector<Message> messages);
+
+		// Values that can be copied as bytes
+		template <typename T>
+		requires std::is_trivially_copyable_v<T>
+		static Message ToMessage(const std::vector<T>& values)
+		{
+			Message message(values.size() * sizeof(T));
+			if (!values.empty())
+			{
+				std::memcpy(message.data(), values.data(), message.size());
+			}
+			return message;
+		}
+		template <typename T>
+		requires std::is_trivially_copyable_v<T>
+		static std::vector<T> FromMessage(const Message& message)
+		{
+			if (message.size() % sizeof(T) != 0U)
+			{
+				throw std::runtime_error("A message has not the size of whole values!");
+			}
+			std::vector<T> values(message.size() / sizeof(T));
+			if (!values.empty())
+			{
+				std::memcpy(values.data(), message.data(), message.size());
+			}
+			return values;
+		}
+
+	private:
+		ProcessGroup(uint32_t rank, std::vector<int> sockets);
+		void CloseAndReport() noexcept;
+
+		uint32_t m_rank{0U};
+		// One socket for every other rank and -1 at our own rank
+		std::vector<int> m_sockets{};
+#ifndef _WIN32
+		// Only rank 0 of a forked group has children to wait for
+		std::vector<pid_t> m_children{};
+#endif
+	};
+} // namespace DiseaseSpreadSimulation
@@ -0,0 +1,65 @@
+#include "Simulation/ProcessGroup.h"
+#include <utility>
+
+// Windows has no fork and no Unix socket pairs, so no group can be created there
+
+DiseaseSpreadSimulation::ProcessGroup DiseaseSpreadSimulation::ProcessGroup::Fork(uint32_t /*processCount*/)
+{
+	throw std::runtime_error("Several processes are not supported on Windows!");
+}
+
+std::vector<DiseaseSpreadSimulation::ProcessGroup> DiseaseSpreadSimulation::ProcessGroup::Connect(uint32_t /*processCount*/)
+{
+	throw std::runtime_error("Several processes are not supported on Windows!");
+}
+
+DiseaseSpreadSimulation::ProcessGroup::ProcessGroup(uint32_t rank, std::vector<int> sockets)
+	: m_rank(rank),
+	  m_sockets(std::move(sockets))
+{
+}
+
+DiseaseSpreadSimulation::ProcessGroup::ProcessGroup(ProcessGroup&& other) noexcept
+	: m_rank(other.m_rank),
+	  m_sockets(std::move(other.m_sockets))
+{
+	other.m_sockets.clear();
+}
+
+DiseaseSpreadSimulation::ProcessGroup& DiseaseSpreadSimulation::ProcessGroup::operator=(ProcessGroup&& other) noexcept
+{
+	if (this != &other)
+	{
+		m_rank = other.m_rank;
+		m_sockets = std::move(other.m_sockets);
+		other.m_sockets.clear();
+	}
+	return *this;
+}
+
+DiseaseSpreadSimulation::ProcessGroup::~ProcessGroup() = default;
+
+void DiseaseSpreadSimulation::ProcessGroup::Close()
+{
+	m_sockets.clear();
+}
+
+void DiseaseSpreadSimulation::ProcessGroup::CloseAndReport() noexcept
+{
+	m_sockets.clear();
+}
+
+uint32_t DiseaseSpreadSimulation::ProcessGroup::Rank() const
+{
+	return m_rank;
+}
+
+uint32_t DiseaseSpreadSimulation::ProcessGroup::Size() const
+{
+	return static_cast<uint32_t>(m_sockets.size());
+}
+
+std::vector<DiseaseSpreadSimulation::ProcessGroup::Message> DiseaseSpreadSimulation::ProcessGroup::Exchange(std::vector<Message> /*messages*/)
+{
+	throw std::runtime_error("Several processes are not supported on Windows!");
+}
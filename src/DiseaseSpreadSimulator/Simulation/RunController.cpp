@@ -0,0 +1,126 @@
+#include "Simulation/RunController.h"
+
+DiseaseSpreadSimulation::RunController::RunController(Simulation& simulation)
+	: m_simulation(simulation)
+{
+	m_worker = std::thread(&RunController::WorkerLoop, this);
+}
+
+DiseaseSpreadSimulation::RunController::~RunController()
+{
+	Stop();
+	{
+		std::lock_guard lockSteps(m_mutex);
+		m_stop = true;
+	}
+	m_hasWork.notify_one();
+	m_worker.join();
+}
+
+std::future<void> DiseaseSpreadSimulation::RunController::Run()
+{
+	return Queue([this]()
+		{
+			m_simulation.Run();
+		});
+}
+
+std::future<uint64_t> DiseaseSpreadSimulation::RunController::AdvanceHours(uint64_t hours)
+{
+	return Queue([this, hours]()
+		{
+			return m_simulation.AdvanceHours(hours);
+		});
+}
+
+std::future<uint64_t> DiseaseSpreadSimulation::RunController::RunUntilDay(uint64_t day)
+{
+	return Queue([this, day]()
+		{
+			return m_simulation.RunUntilDay(day);
+		});
+}
+
+std::future<bool> DiseaseSpreadSimulation::RunController::RunUntil(std::function<bool(const PopulationCounts& counts)> condition, uint64_t maxHours)
+{
+	return Queue([this, condition = std::move(condition), maxHours]()
+		{
+			return m_simulation.RunUntil(condition, maxHours);
+		});
+}
+
+void DiseaseSpreadSimulation::RunController::Pause()
+{
+	{
+		std::lock_guard lockSteps(m_mutex);
+		m_paused = true;
+		m_simulation.Pause();
+	}
+	// Wakes the callers of Wait
+	m_idle.notify_all();
+}
+
+void DiseaseSpreadSimulation::RunController::Resume()
+{
+	std::lock_guard lockSteps(m_mutex);
+	m_paused = false;
+	m_simulation.Resume();
+}
+
+void DiseaseSpreadSimulation::RunController::Stop()
+{
+	{
+		std::lock_guard lockSteps(m_mutex);
+		m_steps.clear();
+		m_paused = false;
+	}
+	m_simulation.Stop();
+}
+
+void DiseaseSpreadSimulation::RunController::ResetRunState()
+{
+	std::lock_guard lockSteps(m_mutex);
+	m_paused = false;
+	m_simulation.ResetRunState();
+}
+
+bool DiseaseSpreadSimulation::RunController::Wait()
+{
+	std::unique_lock lockSteps(m_mutex);
+	m_idle.wait(lockSteps, [this]()
+		{
+			return m_paused || (m_steps.empty() && !m_stepping);
+		});
+	return m_steps.empty() && !m_stepping;
+}
+
+void DiseaseSpreadSimulation::RunController::WorkerLoop()
+{
+	std::function<void()> step{};
+	while (true)
+	{
+		{
+			std::unique_lock lockSteps(m_mutex);
+			m_stepping = false;
+			if (m_steps.empty())
+			{
+				m_idle.notify_all();
+			}
+			m_hasWork.wait(lockSteps, [this]()
+				{
+					return m_stop || !m_steps.empty();
+				});
+			if (m_steps.empty())
+			{
+				return;
+			}
+
+			step = std::move(m_steps.front());
+			m_steps.pop_front();
+			m_stepping = true;
+		}
+
+		// Exceptions end up in the future of the step
+		step();
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "Simulation/Simulation.h"
+
+namespace DiseaseSpreadSimulation
+{
+	// Runs a simulation on its own thread. Steps are queued and run one after another while the caller goes on.
+	// The worker sleeps while there is nothing to do or the simulation is paused.
+	// While steps are queued the simulation must only be used through the controller.
+	class RunController
+	{
+	public:
+		// The simulation has to outlive the controller
+		explicit RunController(Simulation& simulation);
+		RunController(const RunController&) = delete;
+		RunController(RunController&&) = delete;
+		RunController& operator=(const RunController&) = delete;
+		RunController& operator=(RunController&&) = delete;
+		// Stops the simulation and waits for the current step
+		~RunController();
+
+		// The futures get the results of the steps of the simulation or their exceptions.
+		// A step dropped by Stop leaves its future with a std::future_error.
+		std::future<void> Run();
+		std::future<uint64_t> AdvanceHours(uint64_t hours);
+		std::future<uint64_t> RunUntilDay(uint64_t day);
+		std::future<bool> RunUntil(std::function<bool(const PopulationCounts& counts)> condition, uint64_t maxHours = std::numeric_limits<uint64_t>::max());
+
+		// The current step sleeps after its hour until resumed
+		void Pause();
+		void Resume();
+		// Ends the current step after its hour and drops the queued ones. The simulation doesn't simulate any more hours
+		// until ResetRunState is called.
+		void Stop();
+		// Lets the simulation run hours again after Stop or Pause. Call Wait after Stop first, so the stopped step has ended.
+		void ResetRunState();
+
+		// Block until every queued step is done or the simulation is paused, so a paused controller can't block the caller forever.
+		// Returns false when it returned because of the pause.
+		bool Wait();
+
+	private:
+		template <typename Step>
+		auto Queue(Step step) -> std::future<decltype(step())>
+		{
+			// Copyable, so it fits into a std::function
+			auto task = std::make_shared<std::packaged_task<decltype(step())()>>(std::move(step));
+			auto result = task->get_future();
+			{
+				std::lock_guard lockSteps(m_mutex);
+				m_steps.emplace_back([task]()
+					{
+						(*task)();
+					});
+			}
+			m_hasWork.notify_one();
+			return result;
+		}
+
+		void WorkerLoop();
+
+		Simulation& m_simulation;
+
+		std::mutex m_mutex;
+		std::condition_variable m_hasWork;
+		std::condition_variable m_idle;
+		std::deque<std::function<void()>> m_steps{};
+		bool m_stepping{false};
+		bool m_paused{false};
+		bool m_stop{false};
+		// Started last, after everything it uses
+		std::thread m_worker;
+	};
+} // namespace DiseaseSpreadSimulation
@@ -1,231 +1,1380 @@
 #include "Simulation/Simulation.h"
 #include <algorithm>
-#include <execution>
 #include <cmath>
 #include <mutex>
+#include <numeric>
 #include <cassert>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <utility>
 #include "fmt/core.h"
 #include "Disease/DiseaseBuilder.h"
+#include "Simulation/MeasureTime.h"
+#include "Simulation/ProcessGroup.h"
 #include "RandomNumbers.h"
 
-DiseaseSpreadSimulation::Simulation::Simulation(uint64_t populationSize, bool withPrint, const std::string& diseaseFilename, Country country)
+namespace
+{
+	// A person draws its stream when it is created. The infecter gets its real stream with the travel location,
+	// so its draw must not take a number from the stream of whatever task the simulation is created in.
+	DiseaseSpreadSimulation::Person CreateTravelInfecter(uint64_t seed)
+	{
+		using namespace DiseaseSpreadSimulation;
+		Random::Engine stream{seed};
+		Random::StreamGuard streamGuard(stream);
+		return Person{Age_Group::UnderThirty, Sex::Male, PersonBehavior(100U, 100U, 1.F, 1.F), nullptr}; // NOLINT: There is no benefit in named constants here
+	}
+} // namespace
+
+DiseaseSpreadSimulation::Simulation::Simulation(uint64_t populationSize, bool withPrint, const std::string& diseaseFilename, Country country, uint64_t seed, Contact_Model contactModel)
 	: m_withPrint(withPrint),
 	  m_country(country),
 	  m_populationSize(populationSize),
 	  m_diseaseFilename(diseaseFilename),
 	  // log10(x) + 1 casted to int will give us the digit count of x (1=1, 10=2, 100=3,...)
 	  m_initialPopulationSizeDigitCount(static_cast<uint32_t>(std::log10(populationSize)) + 1U),
-	  travelInfecter(Age_Group::UnderThirty, Sex::Male, PersonBehavior(100U, 100U, 1.F, 1.F), nullptr) // NOLINT: There is no benefit in named constants here
+	  travelInfecter(CreateTravelInfecter(seed)),
+	  m_seed(seed),
+	  m_randomStream(seed),
+	  m_contactModel(contactModel)
+{
+	if (m_withPrint)
+	{
+		m_output = std::make_unique<OutputStage>();
+	}
+}
+void DiseaseSpreadSimulation::Simulation::Run()
+{
+	Random::StreamGuard streamGuard(m_randomStream);
+	StartRun();
+
+	if (!isSetupDone)
+	{
+		SetupEverything(1U);
+	}
+
+	while (ContinueRun())
+	{
+		Update();
+	}
+	FlushOutput();
+}
+
+void DiseaseSpreadSimulation::Simulation::RunForDays(uint32_t days)
+{
+	Random::StreamGuard streamGuard(m_randomStream);
+	StartRun();
+
+	if (!isSetupDone)
+	{
+		SetupEverything(1U);
+	}
+
+	const auto runHours = days * 24U;
+	auto hours = 0U;
+	while (hours < runHours && ContinueRun())
+	{
+		Update();
+		hours++;
+	}
+
+	FlushOutput();
+	// Separate the output when we print during the simulation
+	if (m_withPrint)
+	{
+		fmt::print("\n\n");
+	}
+	PrintRunResult(hours / 24U);
+}
+
+void DiseaseSpreadSimulation::Simulation::RunOneHour()
+{
+	Random::StreamGuard streamGuard(m_randomStream);
+	if (!isSetupDone)
+	{
+		SetupEverything(1U);
+	}
+
+	Update();
+}
+
+DiseaseSpreadSimulation::Simulation::RunResult DiseaseSpreadSimulation::Simulation::RunScenario(uint32_t days, DiseaseContainmentMeasures containmentMeasure, const Community* population)
+{
+	Random::StreamGuard streamGuard(m_randomStream);
+	if (!isSetupDone)
+	{
+		m_nextContainmentMeasure = containmentMeasure;
+		SetupEverything(1U, false, population);
+	}
+
+	const auto runHours = days * 24U;
+	for (auto hours = 0U; hours < runHours && ContinueRun(); hours++)
+	{
+		Update();
+	}
+
+	const auto& community = communities.front();
+	return {containmentMeasure, community.GetPopulationStore().Count(), community.NumberOfPositiveTests(), community.NumberOfPersonsQuarantined()};
+}
+
+void DiseaseSpreadSimulation::Simulation::CompareContainmentMeasures(uint32_t runDays, uint32_t numberOfRuns)
+{
+	Random::StreamGuard streamGuard(m_randomStream);
+	SetupEverything(DiseaseContainmentMeasuresEnumSizePlusBase);
+
+	for (auto i = 0U; i < numberOfRuns && ContinueRun(); i++)
+	{
+		// Keep the last run to be able to save it
+		if (i > 0U)
+		{
+			ResetCommunities();
+			ResetElapsedTime();
+		}
+
+		RunForDays(runDays);
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::Stop()
+{
+	m_runState = RunState::Stopped;
+	m_runState.notify_all();
+}
+
+void DiseaseSpreadSimulation::Simulation::Pause()
+{
+	auto running = RunState::Running;
+	m_runState.compare_exchange_strong(running, RunState::Paused);
+}
+
+void DiseaseSpreadSimulation::Simulation::Resume()
+{
+	auto paused = RunState::Paused;
+	if (m_runState.compare_exchange_strong(paused, RunState::Running))
+	{
+		m_runState.notify_all();
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::ResetRunState()
+{
+	m_runState = RunState::Running;
+	m_runState.notify_all();
+}
+
+uint64_t DiseaseSpreadSimulation::Simulation::AdvanceHours(uint64_t hours)
+{
+	Random::StreamGuard streamGuard(m_randomStream);
+	if (!isSetupDone)
+	{
+		SetupEverything(1U);
+	}
+
+	uint64_t simulatedHours{0U};
+	while (simulatedHours < hours && ContinueRun())
+	{
+		Update();
+		simulatedHours++;
+	}
+	FlushOutput();
+	return simulatedHours;
+}
+
+uint64_t DiseaseSpreadSimulation::Simulation::RunUntilDay(uint64_t day)
+{
+	Random::StreamGuard streamGuard(m_randomStream);
+	if (!isSetupDone)
+	{
+		SetupEverything(1U);
+	}
+
+	uint64_t simulatedHours{0U};
+	while (time.GetElapsedDays() < day && ContinueRun())
+	{
+		Update();
+		simulatedHours++;
+	}
+	FlushOutput();
+	return simulatedHours;
+}
+
+bool DiseaseSpreadSimulation::Simulation::RunUntil(const std::function<bool(const PopulationCounts& counts)>& condition, uint64_t maxHours)
+{
+	if (m_processGroup != nullptr && m_processGroup->Size() > 1U)
+	{
+		throw std::runtime_error("A region split over several processes can't run until a condition of its counters!");
+	}
+	Random::StreamGuard streamGuard(m_randomStream);
+	if (!isSetupDone)
+	{
+		SetupEverything(1U);
+	}
+
+	auto isMet = condition(CountPopulation());
+	for (uint64_t hours = 0U; !isMet && hours < maxHours && ContinueRun(); hours++)
+	{
+		Update();
+		isMet = condition(CountPopulation());
+	}
+	FlushOutput();
+	return isMet;
+}
+
+void DiseaseSpreadSimulation::Simulation::FlushOutput() const
+{
+	if (m_output)
+	{
+		m_output->Flush();
+	}
+}
+
+uint64_t DiseaseSpreadSimulation::Simulation::GetElapsedHours() const
+{
+	return time.GetElapsedHours();
+}
+
+bool DiseaseSpreadSimulation::Simulation::ContinueRun()
+{
+	auto state = m_runState.load();
+	while (state == RunState::Paused)
+	{
+		// Sleeps until Resume or Stop change the state
+		m_runState.wait(RunState::Paused);
+		state = m_runState.load();
+	}
+	return state == RunState::Running;
+}
+
+bool DiseaseSpreadSimulation::Simulation::ContinueRegionRun(uint64_t hour)
+{
+	if (m_processGroup == nullptr || m_processGroup->Size() <= 1U)
+	{
+		return ContinueRun();
+	}
+	if (hour % 24U != 0U)
+	{
+		return true;
+	}
+
+	const auto isRunning = static_cast<uint8_t>(ContinueRun() ? 1U : 0U);
+	std::vector<ProcessGroup::Message> messages(m_processGroup->Size(), ProcessGroup::ToMessage(std::vector<uint8_t>{isRunning}));
+	const auto received = m_processGroup->Exchange(std::move(messages));
+	return std::all_of(received.begin(), received.end(), [](const ProcessGroup::Message& message)
+		{
+			const auto values = ProcessGroup::FromMessage<uint8_t>(message);
+			return !values.empty() && values.front() == 1U;
+		});
+}
+
+void DiseaseSpreadSimulation::Simulation::StartRun()
+{
+	std::unique_lock<std::shared_mutex> runNumberLock(runNumberMutex);
+	if (m_continuesLoadedRun)
+	{
+		m_continuesLoadedRun = false;
+		return;
+	}
+	++runNumber;
+}
+
+DiseaseSpreadSimulation::PopulationCounts DiseaseSpreadSimulation::Simulation::CountPopulation() const
+{
+	PopulationCounts total{};
+	for (const auto& community : communities)
+	{
+		const auto counts = community.GetPopulationStore().Count();
+		total.alive += counts.alive;
+		total.susceptible += counts.susceptible;
+		total.exposed += counts.exposed;
+		total.infectious += counts.infectious;
+		total.recovered += counts.recovered;
+		total.withDisease += counts.withDisease;
+		total.traveling += counts.traveling;
+		total.quarantined += counts.quarantined;
+		total.dead += counts.dead;
+		total.everInfected += counts.everInfected;
+	}
+	return total;
+}
+
+void DiseaseSpreadSimulation::Simulation::CreateCommunity(bool maskMandate, bool homeOffice, bool closeShops, bool lockdown)
+{
+	Random::StreamGuard streamGuard(m_randomStream);
+	communities.emplace_back(m_populationSize, m_country, m_pool);
+	auto& setContainmentMeasures = communities.back().SetContainmentMeasures();
+
+	setContainmentMeasures.SetMaskMandate(maskMandate);
+	setContainmentMeasures.SetWorkingFromHome(homeOffice);
+	setContainmentMeasures.SetShopsClosed(closeShops);
+	setContainmentMeasures.SetLockdown(lockdown);
+	
+	InfectRandomPerson(&diseases.back(), communities.back().GetPopulation());
+}
+
+void DiseaseSpreadSimulation::Simulation::SaveSnapshot(const std::string& filename) const
+{
+	PROFILE_ZONE("SaveSnapshot");
+	if (!isSetupDone)
+	{
+		throw std::runtime_error("There is nothing to save before the simulation was set up!");
+	}
+	if (m_processGroup != nullptr && m_processGroup->Size() > 1U)
+	{
+		throw std::runtime_error("A region split over several processes can't be saved into one snapshot!");
+	}
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		throw std::runtime_error(fmt::format("Can't open {} to save the snapshot!", filename));
+	}
+	BinaryWriter writer(file);
+
+	writer.Write(Snapshot::magic);
+	writer.Write(Snapshot::version);
+	writer.Write(m_seed);
+	writer.Write(m_country);
+	writer.Write(m_populationSize);
+	writer.Write(runNumber);
+	writer.Write(elapsedDays);
+	writer.Write(elapsedHours);
+	writer.Write(isNewDay);
+	time.Save(writer);
+
+	writer.Write(static_cast<uint32_t>(diseases.size()));
+	for (const auto& disease : diseases)
+	{
+		writer.Write(nlohmann::json(disease).dump());
+	}
+
+	writer.Write(static_cast<uint32_t>(communities.size()));
+	for (const auto& community : communities)
+	{
+		community.Save(writer, diseases);
+	}
+	travelInfecter.Save(writer, diseases);
+	writer.Write(m_randomStream.GetState());
+
+	if (!file)
+	{
+		throw std::runtime_error(fmt::format("Failed to write the snapshot {}!", filename));
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::LoadSnapshot(const std::string& filename)
+{
+	PROFILE_ZONE("LoadSnapshot");
+	if (m_processGroup != nullptr && m_processGroup->Size() > 1U)
+	{
+		throw std::runtime_error("A region split over several processes can't be loaded from one snapshot!");
+	}
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		throw std::runtime_error(fmt::format("Can't open the snapshot {}!", filename));
+	}
+	BinaryReader reader(file);
+
+	if (reader.Read<uint32_t>() != Snapshot::magic)
+	{
+		throw std::runtime_error(fmt::format("{} is not a snapshot!", filename));
+	}
+	if (const auto version = reader.Read<uint32_t>(); version != Snapshot::version)
+	{
+		throw std::runtime_error(fmt::format("The snapshot {} has version {} but only version {} can be loaded!", filename, version, Snapshot::version));
+	}
+	m_seed = reader.Read<uint64_t>();
+	if (reader.ReadEnum(Country::Germany) != m_country)
+	{
+		throw std::runtime_error(fmt::format("The snapshot {} was saved for another country!", filename));
+	}
+	m_populationSize = reader.Read<uint64_t>();
+	runNumber = reader.Read<uint32_t>();
+	elapsedDays = reader.Read<uint64_t>();
+	elapsedHours = reader.Read<uint64_t>();
+	isNewDay = reader.ReadBool();
+	time.Load(reader);
+
+	// Reserve, because the infections point to the diseases and the persons to their community
+	// Every disease takes at least the size of its json
+	const auto diseaseCount = reader.ReadCount(sizeof(uint64_t));
+	diseases.clear();
+	diseases.reserve(diseaseCount);
+	for (uint32_t i = 0U; i < diseaseCount; i++)
+	{
+		try
+		{
+			diseases.push_back(nlohmann::json::parse(reader.ReadString()).get<Disease>());
+		}
+		catch (const nlohmann::json::exception& error)
+		{
+			throw std::runtime_error(fmt::format("The snapshot {} contains a broken disease: {}", filename, error.what()));
+		}
+	}
+
+	const auto communityCount = reader.ReadCount(Community::minSnapshotSize);
+	communities.clear();
+	communities.reserve(communityCount);
+	for (uint32_t i = 0U; i < communityCount; i++)
+	{
+		communities.emplace_back(0U, m_country);
+		communities.back().Load(reader, diseases);
+	}
+	if (communities.empty())
+	{
+		throw std::runtime_error(fmt::format("The snapshot {} contains no community!", filename));
+	}
+	if (m_mobility != nullptr && communities.size() != m_mobility->CommunityCount())
+	{
+		throw std::runtime_error(fmt::format("The snapshot {} has {} communities but the region has {}!", filename, communities.size(), m_mobility->CommunityCount()));
+	}
+	travelInfecter.SetCommunity(&communities.front());
+	travelInfecter.Load(reader, diseases);
+	m_randomStream = Random::Engine{reader.Read<uint64_t>()};
+
+	isSetupDone = true;
+	m_continuesLoadedRun = true;
+
+	fmt::print("Snapshot loaded{:^10}", '-');
+	fmt::print("{} disease and {} communities after {} days with seed {}\n", diseases.size(), communities.size(), elapsedDays, m_seed);
+}
+
+void DiseaseSpreadSimulation::Simulation::Update()
+{
+	PROFILE_ZONE("Update");
+	time.Update();
+
+	isNewDay = CheckForNewDay();
+
+	while (elapsedHours <= time.GetElapsedHours())
+	{
+		m_infectionEvents.resize(communities.size());
+		m_communityHours.resize(communities.size());
+		if (m_mobility != nullptr)
+		{
+			UpdateRegion();
+		}
+		else if (m_pool != nullptr)
+		{
+			RunHourGraph();
+		}
+		else
+		{
+			for (uint32_t index = 0U; index < communities.size(); index++)
+			{
+				UpdateCommunity(index);
+			}
+		}
+
+		if (m_mobility != nullptr)
+		{
+			// Every process takes part, even when only rank 0 writes and prints
+			if (isNewDay)
+			{
+				auto records = GatherRegionCounters();
+				if (m_withPrint && IsRoot())
+				{
+					// Printed by the output stage while the next hour is simulated
+					m_output->Submit([records, day = elapsedDays]()
+						{
+							PrintRegionDay(day, records);
+						});
+				}
+				if (m_timeSeries != nullptr && IsRoot())
+				{
+					m_timeSeries->Append(std::move(records));
+				}
+			}
+		}
+		else
+		{
+			if (m_timeSeries != nullptr && isNewDay)
+			{
+				AppendTimeSeries();
+			}
+			if (m_withPrint)
+			{
+				Print();
+			}
+		}
+		elapsedHours++;
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::UpdateCommunity(uint32_t communityIndex)
+{
+	BeginPopulationUpdate(communityIndex);
+	UpdatePersons(communityIndex, 0U, 1U);
+	PrepareTransfers(communityIndex);
+	LeavePlaces(communityIndex, 0U, 1U);
+	ArriveAtPlaces(communityIndex, 0U, 1U);
+	FinishPopulationUpdate(communityIndex);
+	communities[communityIndex].IndexPlaces();
+	CollectPlaceInfections(communityIndex, 0U, 1U);
+	CollectTravelInfections(communityIndex);
+	SpreadDisease(communityIndex, 0U, 1U);
+	SpreadTravelInfections(communityIndex);
+}
+
+void DiseaseSpreadSimulation::Simulation::BeginPopulationUpdate(uint32_t communityIndex)
+{
+	auto& community = communities[communityIndex];
+	auto& scheduler = community.GetUpdateScheduler();
+	auto& hour = m_communityHours[communityIndex];
+
+	// Persons only decide where to go while they are updated. The moves are applied afterwards place by place.
+	community.DeferTransfers(true);
+
+	// Everybody is updated at the start of a day. During the day only persons with something to do are updated.
+	hour.isEveryoneDue = isNewDay || scheduler.IsEveryoneDue();
+	hour.due = hour.isEveryoneDue ? nullptr : &scheduler.TakeDue(time.GetTime());
+}
+
+void DiseaseSpreadSimulation::Simulation::UpdatePersons(uint32_t communityIndex, size_t chunk, size_t chunkCount)
+{
+	PROFILE_ZONE("UpdatePopulation");
+	auto& population = communities[communityIndex].GetPopulation();
+	const auto& hour = m_communityHours[communityIndex];
+	const auto currentTime = time.GetTime();
+	const auto isWorkday = time.IsWorkday();
+
+	if (hour.isEveryoneDue)
+	{
+		const auto [begin, end] = ChunkRange(population.size(), chunk, chunkCount);
+		for (auto index = begin; index < end; index++)
+		{
+			population[index].Update(currentTime, isWorkday, isNewDay);
+		}
+		return;
+	}
+
+	const auto& due = *hour.due;
+	const auto [begin, end] = ChunkRange(due.size(), chunk, chunkCount);
+	for (auto i = begin; i < end; i++)
+	{
+		population[due[i]].Update(currentTime, isWorkday, false);
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::PrepareTransfers(uint32_t communityIndex)
+{
+	auto& community = communities[communityIndex];
+	const auto& hour = m_communityHours[communityIndex];
+
+	community.DeferTransfers(false);
+	if (hour.isEveryoneDue)
+	{
+		community.PrepareTransfers();
+	}
+	else
+	{
+		community.PrepareTransfers(*hour.due);
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::LeavePlaces(uint32_t communityIndex, size_t chunk, size_t chunkCount)
+{
+	communities[communityIndex].LeavePlaces(chunk, chunkCount);
+}
+
+void DiseaseSpreadSimulation::Simulation::ArriveAtPlaces(uint32_t communityIndex, size_t chunk, size_t chunkCount)
+{
+	communities[communityIndex].ArriveAtPlaces(chunk, chunkCount);
+}
+
+void DiseaseSpreadSimulation::Simulation::FinishPopulationUpdate(uint32_t communityIndex)
+{
+	auto& community = communities[communityIndex];
+	auto& population = community.GetPopulation();
+	auto& scheduler = community.GetUpdateScheduler();
+	const auto& hour = m_communityHours[communityIndex];
+	const auto currentTime = time.GetTime();
+	const auto isWorkday = time.IsWorkday();
+
+	if (hour.isEveryoneDue)
+	{
+		scheduler.Clear();
+		for (uint32_t index = 0U; index < static_cast<uint32_t>(population.size()); index++)
+		{
+			scheduler.Schedule(index, population[index].NextUpdateTime(currentTime, isWorkday));
+		}
+	}
+	else
+	{
+		for (const auto index : *hour.due)
+		{
+			scheduler.Schedule(index, population[index].NextUpdateTime(currentTime, isWorkday));
+		}
+	}
+
+	// One list of infections for every place and one for the travel location
+	m_infectionEvents[communityIndex].resize(community.GetPlaces().Count() + 1U);
+	community.PreparePlaceTable();
+}
+
+std::pair<size_t, size_t> DiseaseSpreadSimulation::Simulation::ChunkRange(size_t count, size_t chunk, size_t chunkCount)
+{
+	return {count * chunk / chunkCount, count * (chunk + 1U) / chunkCount};
+}
+
+void DiseaseSpreadSimulation::Simulation::RunHourGraph()
+{
+	PROFILE_ZONE("HourGraph");
+	if (m_hourGraph.TaskCount() == 0U || m_hourGraphCommunityCount != communities.size())
+	{
+		BuildHourGraph();
+	}
+	m_hourSeed = Random::StreamSeed(Random::StreamSeed(m_seed, taskStreamID), elapsedHours);
+	m_hourGraph.Run(*m_pool);
+}
+
+void DiseaseSpreadSimulation::Simulation::BuildHourGraph()
+{
+	m_hourGraph.Clear();
+	m_hourGraphCommunityCount = communities.size();
+	const auto chunkCount = m_pool->ThreadCount();
+	std::optional<TaskGraph::TaskID> previousTravelSpread{};
+	for (uint32_t index = 0U; index < communities.size(); index++)
+	{
+		// Draws outside of a person stream come from the stream of the task, so they don't depend on the worker
+		const auto add = [this, index](auto work, const std::vector<TaskGraph::TaskID>& dependencies)
+		{
+			return m_hourGraph.Add([this, index, work]()
+				{
+					Random::Engine stream{Random::StreamSeed(m_hourSeed, uint64_t{m_firstCommunity} + index)};
+					Random::StreamGuard streamGuard(stream);
+					work();
+				},
+				dependencies);
+		};
+		const auto addChunks = [this, index, chunkCount, &add](void (Simulation::*step)(uint32_t, size_t, size_t), const std::vector<TaskGraph::TaskID>& dependencies)
+		{
+			std::vector<TaskGraph::TaskID> chunks{};
+			for (size_t chunk = 0; chunk < chunkCount; chunk++)
+			{
+				chunks.push_back(add([this, index, chunk, chunkCount, step]()
+					{
+						(this->*step)(index, chunk, chunkCount);
+					},
+					dependencies));
+			}
+			return chunks;
+		};
+
+		// Every community is a chain of its own. Only the travel infecter is shared by the communities.
+		const auto begin = add([this, index]()
+			{
+				BeginPopulationUpdate(index);
+			},
+			{});
+		const auto persons = addChunks(&Simulation::UpdatePersons, {begin});
+		const auto prepare = add([this, index]()
+			{
+				PrepareTransfers(index);
+			},
+			persons);
+		const auto leave = addChunks(&Simulation::LeavePlaces, {prepare});
+		const auto arrive = addChunks(&Simulation::ArriveAtPlaces, leave);
+		const auto finish = add([this, index]()
+			{
+				FinishPopulationUpdate(index);
+			},
+			arrive);
+		const auto indexing = addChunks(&Simulation::IndexPlaces, {finish});
+		const auto indexed = add([this, index]()
+			{
+				communities[index].FinishPlaceTable();
+			},
+			indexing);
+		const auto places = addChunks(&Simulation::CollectPlaceInfections, {indexed});
+		const auto travel = add([this, index]()
+			{
+				CollectTravelInfections(index);
+			},
+			{finish});
+		auto spread = addChunks(&Simulation::SpreadDisease, places);
+
+		if (m_mobility != nullptr)
+		{
+			spread.push_back(travel);
+			add([this, index]()
+				{
+					SendTravelers(index);
+				},
+				spread);
+			continue;
+		}
+		// The travel infecter counts its spreads, so the communities take turns
+		std::vector<TaskGraph::TaskID> travelDependencies{travel};
+		if (previousTravelSpread)
+		{
+			travelDependencies.push_back(*previousTravelSpread);
+		}
+		previousTravelSpread = add([this, index]()
+			{
+				SpreadTravelInfections(index);
+			},
+			travelDependencies);
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::UpdateRegion()
+{
+	PROFILE_ZONE("UpdateRegion");
+	const auto communityCount = static_cast<uint32_t>(communities.size());
+	const auto regionSize = m_mobility->CommunityCount();
+	RunHourGraph();
+	HandOverVisitors();
+
+	// Draws outside of a person stream come from the stream of the task, so they don't depend on the worker
+	const auto submit = [this](uint64_t streamID, auto task)
+	{
+		m_pool->Submit([hourSeed = m_hourSeed, streamID, task]()
+			{
+				Random::Engine stream{Random::StreamSeed(hourSeed, streamID)};
+				Random::StreamGuard streamGuard(stream);
+				task();
+			});
+	};
+
+	// The residents are only touched by the task of their community
+	m_visitResults.resize(communityCount);
+	for (uint32_t index = 0U; index < communityCount; index++)
+	{
+		submit(uint64_t{regionSize} + m_firstCommunity + index, [this, index]()
+			{
+				VisitCommunity(index);
+			});
+	}
+	m_pool->Wait();
+	HandBackVisitResults();
+}
+
+void DiseaseSpreadSimulation::Simulation::SendTravelers(uint32_t communityIndex)
+{
+	const auto source = m_firstCommunity + communityIndex;
+	m_travelExchange.Clear(source);
+	auto& population = communities[communityIndex].GetPopulation();
+	for (auto* traveler : communities[communityIndex].GetTravelLocation().GetPeople())
+	{
+		if (!traveler->IsAlive())
+		{
+			continue;
+		}
+		// The destination is kept for the whole trip
+		if (traveler->GetTravelDestination() == Person::noDestination)
+		{
+			traveler->SetTravelDestination(m_mobility->PickDestination(source, traveler->GetRandomStream()));
+		}
+
+		Visitor visitor{};
+		visitor.randomState = traveler->GetRandomStream().GetState();
+		visitor.susceptibility = traveler->GetSusceptibility();
+		visitor.source = source;
+		visitor.destination = traveler->GetTravelDestination();
+		visitor.index = static_cast<uint32_t>(traveler - population.data());
+		if (const auto* disease = traveler->GetDisease(); disease != nullptr)
+		{
+			visitor.disease = static_cast<uint32_t>(disease - diseases.data());
+		}
+		visitor.spreadFactor = traveler->GetSpreadFactor();
+		visitor.isSusceptible = traveler->IsSusceptible();
+		visitor.isInfectious = traveler->IsInfectious();
+		m_travelExchange.Send(visitor);
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::HandOverVisitors()
+{
+	PROFILE_ZONE("HandOverVisitors");
+	m_visitors.resize(communities.size());
+	for (uint32_t index = 0U; index < m_visitors.size(); index++)
+	{
+		m_visitors[index] = m_travelExchange.Arrivals(m_firstCommunity + index);
+	}
+	if (m_processGroup == nullptr || m_processGroup->Size() == 1U)
+	{
+		return;
+	}
+
+	std::vector<ProcessGroup::Message> messages(m_processGroup->Size());
+	for (uint32_t rank = 0U; rank < m_processGroup->Size(); rank++)
+	{
+		if (rank == m_processGroup->Rank())
+		{
+			continue;
+		}
+		std::vector<Visitor> visitors{};
+		const auto [first, last] = RegionBlock(rank);
+		for (auto destination = first; destination < last; destination++)
+		{
+			const auto arrivals = m_travelExchange.Arrivals(destination);
+			visitors.insert(visitors.end(), arrivals.begin(), arrivals.end());
+		}
+		messages[rank] = ProcessGroup::ToMessage(visitors);
+	}
+
+	auto received = m_processGroup->Exchange(std::move(messages));
+	for (uint32_t rank = 0U; rank < received.size(); rank++)
+	{
+		if (rank == m_processGroup->Rank())
+		{
+			continue;
+		}
+		for (const auto& visitor : ProcessGroup::FromMessage<Visitor>(received[rank]))
+		{
+			if (visitor.destination < m_firstCommunity || visitor.destination - m_firstCommunity >= m_visitors.size())
+			{
+				throw std::runtime_error(fmt::format("Rank {} sent a visitor of community {} to the wrong process!", rank, visitor.destination));
+			}
+			m_visitors[visitor.destination - m_firstCommunity].push_back(visitor);
+		}
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::VisitCommunity(uint32_t communityIndex)
+{
+	PROFILE_ZONE("VisitCommunity");
+	auto& visitors = m_visitors[communityIndex];
+	// Sort them to make the draws independent of the order they arrived in
+	std::sort(visitors.begin(), visitors.end(), [](const Visitor& lhs, const Visitor& rhs)
+		{
+			return std::pair{lhs.source, lhs.index} < std::pair{rhs.source, rhs.index};
+		});
+
+	// Every visitor meets a random number of residents. Both draw from their own stream like at a place.
+	auto& residents = communities[communityIndex].GetPopulation();
+	auto& results = m_visitResults[communityIndex];
+	results.clear();
+	std::vector<std::pair<size_t, Person*>> infectedResidents{};
+	for (const auto& visitor : visitors)
+	{
+		VisitResult result{visitor.randomState, visitor.source, visitor.index};
+		Random::Engine stream{visitor.randomState};
+		Random::StreamGuard streamGuard(stream);
+		const auto numberOfContacts = Random::UniformIntRange(minTravelContacts, maxTravelContacts);
+		for (auto i = 0U; i < numberOfContacts; i++)
+		{
+			auto& resident = residents[Random::RandomVectorIndex(residents)];
+			// Nobody is met who is away or dead
+			if (resident.IsTraveling() || !resident.IsAlive())
+			{
+				continue;
+			}
+			if (visitor.isSusceptible && result.infectedBy == Visitor::noDisease && resident.IsInfectious())
+			{
+				if (Random::UnitDouble(stream()) < static_cast<double>(resident.GetSpreadFactor()) * visitor.susceptibility)
+				{
+					result.infectedBy = static_cast<uint32_t>(resident.GetDisease() - diseases.data());
+					resident.IncreaseSpreadCount();
+				}
+			}
+			else if (visitor.isInfectious && resident.IsSusceptible())
+			{
+				Random::StreamGuard residentGuard(resident.GetRandomStream());
+				if (Random::UnitDouble(Random::Generator()()) < static_cast<double>(visitor.spreadFactor) * resident.GetSusceptibility())
+				{
+					infectedResidents.emplace_back(results.size(), &resident);
+				}
+			}
+		}
+		result.randomState = stream.GetState();
+		results.push_back(result);
+	}
+
+	// The first infection of a resident counts
+	for (const auto& [visitor, resident] : infectedResidents)
+	{
+		if (resident->IsSusceptible())
+		{
+			resident->Contaminate(&diseases.at(visitors[visitor].disease));
+			results[visitor].spreadCount++;
+		}
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::HandBackVisitResults()
+{
+	PROFILE_ZONE("HandBackVisitResults");
+	const auto processCount = m_processGroup != nullptr ? m_processGroup->Size() : 1U;
+	const auto ourRank = m_processGroup != nullptr ? m_processGroup->Rank() : 0U;
+	std::vector<std::vector<VisitResult>> outgoing(processCount);
+	for (const auto& results : m_visitResults)
+	{
+		for (const auto& result : results)
+		{
+			const auto rank = RankOfCommunity(result.source);
+			if (rank == ourRank)
+			{
+				ApplyVisitResult(result);
+				continue;
+			}
+			outgoing[rank].push_back(result);
+		}
+	}
+	if (processCount == 1U)
+	{
+		return;
+	}
+
+	std::vector<ProcessGroup::Message> messages{};
+	messages.reserve(processCount);
+	for (const auto& results : outgoing)
+	{
+		messages.push_back(ProcessGroup::ToMessage(results));
+	}
+	for (const auto& message : m_processGroup->Exchange(std::move(messages)))
+	{
+		for (const auto& result : ProcessGroup::FromMessage<VisitResult>(message))
+		{
+			ApplyVisitResult(result);
+		}
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::ApplyVisitResult(const VisitResult& result)
+{
+	if (result.source < m_firstCommunity || result.source - m_firstCommunity >= communities.size())
+	{
+		throw std::runtime_error(fmt::format("Got the visit result of community {} from another process!", result.source));
+	}
+	auto& traveler = communities[result.source - m_firstCommunity].GetPopulation().at(result.index);
+	traveler.GetRandomStream().SetState(result.randomState);
+	if (result.infectedBy != Visitor::noDisease && traveler.IsSusceptible())
+	{
+		traveler.Contaminate(&diseases.at(result.infectedBy));
+	}
+	for (auto i = 0U; i < result.spreadCount; i++)
+	{
+		traveler.IncreaseSpreadCount();
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::IndexPlaces(uint32_t communityIndex, size_t chunk, size_t chunkCount)
 {
+	communities[communityIndex].IndexPlaces(chunk, chunkCount);
 }
-void DiseaseSpreadSimulation::Simulation::Run()
+
+void DiseaseSpreadSimulation::Simulation::CollectPlaceInfections(uint32_t communityIndex, size_t chunk, size_t chunkCount)
 {
+	PROFILE_ZONE("Contacts");
+	// First all contacts are evaluated on the unchanged states. Only the random streams of the susceptible persons are advanced.
+	// Afterwards the found infections are applied.
+	auto& community = communities[communityIndex];
+	const auto& placeTable = community.GetPlaceTable();
+	auto& events = m_infectionEvents[communityIndex];
+	const auto [begin, end] = ChunkRange(events.size() - 1U, chunk, chunkCount);
+	for (auto placeIndex = begin; placeIndex < end; placeIndex++)
 	{
-		std::unique_lock<std::shared_mutex> runNumberLock(runNumberMutex);
-		++runNumber;
+		CollectInfections(community.GetPopulation(), placeTable.GetOccupants(static_cast<uint32_t>(placeIndex)), m_contactModel, events[placeIndex]);
 	}
+}
 
-	if (!isSetupDone)
+void DiseaseSpreadSimulation::Simulation::CollectTravelInfections(uint32_t communityIndex)
+{
+	PROFILE_ZONE("Contacts");
+	auto& travelEvents = m_infectionEvents[communityIndex].back();
+	travelEvents.clear();
+	// Linked communities send their travelers to meet the residents of other communities instead
+	if (m_mobility != nullptr)
 	{
-		SetupEverything(1U);
+		return;
 	}
 
-	while (!stop)
+	// Random number of contacts for travelers
+	for (auto* traveler : communities[communityIndex].GetTravelLocation().GetPeople())
 	{
-		while (pause)
+		Random::StreamGuard streamGuard(traveler->GetRandomStream());
+		auto numberOfContacts = Random::UniformIntRange(minTravelContacts, maxTravelContacts);
+		if (!traveler->IsSusceptible() || !travelInfecter.IsInfectious())
 		{
-			// Idle when pause is called until resumed
+			continue;
 		}
 
-		Update();
+		if (m_contactModel == Contact_Model::Aggregated)
+		{
+			// Chance to escape every contact
+			const auto escape = std::pow(1. - static_cast<double>(travelInfecter.GetSpreadFactor()) * traveler->GetSusceptibility(), numberOfContacts);
+			if (escape <= Random::Percent<double>())
+			{
+				travelEvents.push_back({&travelInfecter, traveler});
+			}
+			continue;
+		}
+		for (auto i = 0U; i < numberOfContacts; i++)
+		{
+			if (traveler->WillBeInfectedBy(travelInfecter))
+			{
+				travelEvents.push_back({&travelInfecter, traveler});
+				break;
+			}
+		}
 	}
 }
 
-void DiseaseSpreadSimulation::Simulation::RunForDays(uint32_t days)
+void DiseaseSpreadSimulation::Simulation::SpreadDisease(uint32_t communityIndex, size_t chunk, size_t chunkCount)
 {
+	PROFILE_ZONE("SpreadDisease");
+	// Every person is inside one place only, so the lists don't share any person and can be applied side by side
+	auto& events = m_infectionEvents[communityIndex];
+	const auto [begin, end] = ChunkRange(events.size() - 1U, chunk, chunkCount);
+	for (auto placeIndex = begin; placeIndex < end; placeIndex++)
 	{
-		std::unique_lock<std::shared_mutex> runNumberLock(runNumberMutex);
-		++runNumber;
+		for (const auto& event : events[placeIndex])
+		{
+			Person::SpreadDisease(*event.spreader, *event.infected);
+		}
 	}
+}
 
-	if (!isSetupDone)
+void DiseaseSpreadSimulation::Simulation::SpreadTravelInfections(uint32_t communityIndex)
+{
+	PROFILE_ZONE("SpreadDisease");
+	for (const auto& event : m_infectionEvents[communityIndex].back())
 	{
-		SetupEverything(1U);
+		Person::SpreadDisease(*event.spreader, *event.infected);
 	}
+}
 
-	const auto runHours = days * 24U;
+void DiseaseSpreadSimulation::Simulation::CollectInfections(std::vector<Person>& population, std::span<const uint32_t> occupants, Contact_Model contactModel, std::vector<InfectionEvent>& events)
+{
+	events.clear();
 
-	for (auto hours = 0U; hours < runHours; hours++)
+	// Get all susceptible and infectious people
+	std::vector<Person*> susceptible{};
+	susceptible.reserve(occupants.size());
+	std::vector<Person*> infectious{};
+	infectious.reserve(occupants.size());
+	for (const auto index : occupants)
 	{
-		Update();
+		auto& person = population[index];
+		if (person.IsSusceptible())
+		{
+			susceptible.push_back(&person);
+		}
+		else if (person.IsInfectious())
+		{
+			infectious.push_back(&person);
+		}
+	}
+	if (infectious.empty())
+	{
+		return;
 	}
 
-	// Separate the output when we print during the simulation
-	if (m_withPrint)
+	// Sort them to make the draws independent of the order of the people inside the place
+	const auto byID = [](const Person* lhs, const Person* rhs)
 	{
-		fmt::print("\n\n");
+		return lhs->GetID() < rhs->GetID();
+	};
+	std::sort(susceptible.begin(), susceptible.end(), byID);
+	std::sort(infectious.begin(), infectious.end(), byID);
+
+	// The susceptible people as arrays, so their draws can be taken in one batch
+	std::vector<double> susceptibilities{};
+	susceptibilities.reserve(susceptible.size());
+	std::vector<uint64_t> streamStates{};
+	streamStates.reserve(susceptible.size());
+	for (auto* susceptiblePerson : susceptible)
+	{
+		susceptibilities.push_back(susceptiblePerson->GetSusceptibility());
+		streamStates.push_back(susceptiblePerson->GetRandomStream().GetState());
 	}
-	PrintRunResult(days);
-}
+	const auto storeStreamStates = [&susceptible, &streamStates]()
+	{
+		for (size_t i = 0; i < susceptible.size(); i++)
+		{
+			susceptible[i]->GetRandomStream().SetState(streamStates[i]);
+		}
+	};
 
-void DiseaseSpreadSimulation::Simulation::CompareContainmentMeasures(uint32_t runDays, uint32_t numberOfRuns)
-{
-	SetupEverything(DiseaseContainmentMeasuresEnumSizePlusBase);
+	if (contactModel == Contact_Model::Aggregated)
+	{
+		std::vector<double> spreadFactors{};
+		spreadFactors.reserve(infectious.size());
+		for (const auto* infectiousPerson : infectious)
+		{
+			spreadFactors.push_back(static_cast<double>(infectiousPerson->GetSpreadFactor()));
+		}
+
+		std::vector<double> draws(susceptible.size());
+		for (size_t i = 0; i < draws.size(); i++)
+		{
+			draws[i] = Random::UnitDouble(Random::Engine::Next(streamStates[i]));
+		}
+		storeStreamStates();
+
+		// One draw for every susceptible person. The chance to escape shrinks with every infectious person in order.
+		// The first one that lets it fall to the draw or below is the spreader. This has the same chances as the pairwise contacts.
+		for (size_t person = 0; person < susceptible.size(); person++)
+		{
+			double escape{1.};
+			for (size_t i = 0; i < spreadFactors.size(); i++)
+			{
+				escape *= 1. - spreadFactors[i] * susceptibilities[person];
+				if (escape <= draws[person])
+				{
+					events.push_back({infectious[i], susceptible[person]});
+					break;
+				}
+			}
+		}
+		return;
+	}
 
-	for (auto i = 0U; i < numberOfRuns; i++)
+	// Every infectious person has a chance to infect a susceptible person. The first one that does is the spreader.
+	// The contacts of one infectious person with everyone still susceptible are drawn as one batch. Every person still draws
+	// from its stream in the order of the infectious people, so this is the same as going through them person by person.
+	std::vector<Person*> spreaders(susceptible.size(), nullptr);
+	// Index into susceptible of every batch entry
+	std::vector<size_t> remaining(susceptible.size());
+	std::iota(remaining.begin(), remaining.end(), size_t{0U});
+	std::vector<double> batchSusceptibilities{susceptibilities};
+	std::vector<uint64_t> batchStates{streamStates};
+	std::vector<uint8_t> infected(susceptible.size());
+	for (auto* infectiousPerson : infectious)
 	{
-		RunForDays(runDays);
+		Infection::WillInfect(static_cast<double>(infectiousPerson->GetSpreadFactor()), batchSusceptibilities, batchStates, infected);
 
-		ResetCommunities();
-		ResetElapsedTime();
+		// Keep the states of everyone and remove the infected people from the batch
+		size_t kept{0U};
+		for (size_t i = 0; i < remaining.size(); i++)
+		{
+			const auto index = remaining[i];
+			streamStates[index] = batchStates[i];
+			if (infected[i] != 0U)
+			{
+				spreaders[index] = infectiousPerson;
+				continue;
+			}
+			remaining[kept] = index;
+			batchSusceptibilities[kept] = batchSusceptibilities[i];
+			batchStates[kept] = batchStates[i];
+			kept++;
+		}
+		remaining.resize(kept);
+		batchSusceptibilities.resize(kept);
+		batchStates.resize(kept);
+		infected.resize(kept);
+		if (remaining.empty())
+		{
+			break;
+		}
+	}
+	storeStreamStates();
+
+	for (size_t i = 0; i < susceptible.size(); i++)
+	{
+		if (spreaders[i] != nullptr)
+		{
+			events.push_back({spreaders[i], susceptible[i]});
+		}
 	}
 }
 
-void DiseaseSpreadSimulation::Simulation::Stop()
+void DiseaseSpreadSimulation::Simulation::SetTimeSeriesSink(TimeSeriesSink* sink)
 {
-	stop = true;
+	m_timeSeries = sink;
 }
 
-void DiseaseSpreadSimulation::Simulation::Pause()
+void DiseaseSpreadSimulation::Simulation::SetPopulationCache(const PopulationCache* cache)
 {
-	pause = true;
+	m_populationCache = cache;
 }
 
-void DiseaseSpreadSimulation::Simulation::Resume()
+void DiseaseSpreadSimulation::Simulation::SetMobility(const MobilityMatrix* mobility, ThreadPool* pool, ProcessGroup* processGroup)
 {
-	pause = false;
+	const auto processCount = processGroup != nullptr ? processGroup->Size() : 1U;
+	if (mobility != nullptr && (pool == nullptr || mobility->CommunityCount() < processCount))
+	{
+		throw std::invalid_argument("The mobility needs a pool and at least one community for every process!");
+	}
+	m_mobility = mobility;
+	m_pool = pool;
+	m_processGroup = processGroup;
+	m_hourGraph.Clear();
+	if (mobility == nullptr)
+	{
+		m_firstCommunity = 0U;
+		m_travelExchange = TravelExchange{};
+		return;
+	}
+
+	const auto [first, last] = RegionBlock(processGroup != nullptr ? processGroup->Rank() : 0U);
+	if (isSetupDone && last - first != communities.size())
+	{
+		throw std::invalid_argument("The mobility needs a community for every community of the simulation!");
+	}
+	m_firstCommunity = first;
+	m_travelExchange = TravelExchange{*mobility};
 }
 
-void DiseaseSpreadSimulation::Simulation::CreateCommunity(bool maskMandate, bool homeOffice, bool closeShops, bool lockdown)
+void DiseaseSpreadSimulation::Simulation::SetThreadPool(ThreadPool* pool)
 {
-	communities.emplace_back(m_populationSize, m_country);
-	auto& setContainmentMeasures = communities.back().SetContainmentMeasures();
-
-	setContainmentMeasures.SetMaskMandate(maskMandate);
-	setContainmentMeasures.SetWorkingFromHome(homeOffice);
-	setContainmentMeasures.SetShopsClosed(closeShops);
-	setContainmentMeasures.SetLockdown(lockdown);
-	
-	InfectRandomPerson(&diseases.back(), communities.back().GetPopulation());
+	if (m_mobility != nullptr && pool == nullptr)
+	{
+		throw std::invalid_argument("The mobility needs a pool!");
+	}
+	m_pool = pool;
+	m_hourGraph.Clear();
 }
 
-void DiseaseSpreadSimulation::Simulation::Update()
+void DiseaseSpreadSimulation::Simulation::RunRegion(uint32_t days, DiseaseContainmentMeasures containmentMeasure)
 {
-	time.Update();
+	if (m_mobility == nullptr)
+	{
+		throw std::logic_error("A region can only be run after the mobility is set!");
+	}
+	Random::StreamGuard streamGuard(m_randomStream);
+	StartRun();
 
-	isNewDay = CheckForNewDay();
+	if (!isSetupDone)
+	{
+		m_nextContainmentMeasure = containmentMeasure;
+		const auto [first, last] = RegionBlock(m_processGroup != nullptr ? m_processGroup->Rank() : 0U);
+		SetupEverything(last - first, IsRoot());
+	}
 
-	while (elapsedHours <= time.GetElapsedHours())
+	const auto runHours = days * 24U;
+	auto hours = 0U;
+	for (; hours < runHours && ContinueRegionRun(hours); hours++)
 	{
-		for (auto& community : communities)
-		{
-			auto& population = community.GetPopulation();
+		Update();
+	}
 
-			UpdatePopulation(population);
+	const auto records = GatherRegionCounters();
+	if (!IsRoot())
+	{
+		return;
+	}
+	FlushOutput();
+	// Separate the output when we print during the simulation
+	if (m_withPrint)
+	{
+		fmt::print("\n\n");
+	}
+	PrintRegionResult(hours / 24U, records);
+}
 
-			Contacts(community.GetPlaces(), community.GetTravelLocation());
-		}
+std::pair<uint32_t, uint32_t> DiseaseSpreadSimulation::Simulation::RegionBlock(uint32_t rank) const
+{
+	const uint64_t communityCount{m_mobility->CommunityCount()};
+	const uint64_t processCount{m_processGroup != nullptr ? m_processGroup->Size() : 1U};
+	return {static_cast<uint32_t>(communityCount * rank / processCount), static_cast<uint32_t>(communityCount * (rank + 1U) / processCount)};
+}
 
-		if (m_withPrint)
+uint32_t DiseaseSpreadSimulation::Simulation::RankOfCommunity(uint32_t regionIndex) const
+{
+	const auto processCount = m_processGroup != nullptr ? m_processGroup->Size() : 1U;
+	for (uint32_t rank = 0U; rank < processCount; rank++)
+	{
+		if (regionIndex < RegionBlock(rank).second)
 		{
-			Print();
+			return rank;
 		}
-		elapsedHours++;
 	}
+	throw std::out_of_range(fmt::format("There is no community {} inside the region!", regionIndex));
 }
 
-void DiseaseSpreadSimulation::Simulation::UpdatePopulation(std::vector<Person>& population)
+bool DiseaseSpreadSimulation::Simulation::IsRoot() const
 {
-	std::for_each(std::execution::par_unseq, population.begin(), population.end(), [this](auto& person)
-		{
-			person.Update(time.GetTime(), time.IsWorkday(), isNewDay);
-		});
+	return m_processGroup == nullptr || m_processGroup->Rank() == 0U;
 }
 
-void DiseaseSpreadSimulation::Simulation::Contacts(Places& places, Travel& travelLocation)
+void DiseaseSpreadSimulation::Simulation::AppendTimeSeries() const
 {
-	std::for_each(std::execution::par_unseq, places.homes.begin(), places.homes.end(), [](auto& place)
-		{
-			ContactForPlace(place);
-		});
-	std::for_each(std::execution::par_unseq, places.supplyStores.begin(), places.supplyStores.end(), [](auto& place)
-		{
-			ContactForPlace(place);
-		});
-	std::for_each(std::execution::par_unseq, places.workplaces.begin(), places.workplaces.end(), [](auto& place)
-		{
-			ContactForPlace(place);
-		});
-	std::for_each(std::execution::par_unseq, places.schools.begin(), places.schools.end(), [](auto& place)
-		{
-			ContactForPlace(place);
-		});
-	std::for_each(std::execution::par_unseq, places.hardwareStores.begin(), places.hardwareStores.end(), [](auto& place)
-		{
-			ContactForPlace(place);
-		});
+	PROFILE_ZONE("TimeSeries");
+	// Only the counting happens here, the sink formats and writes on its own thread
+	m_timeSeries->Append(CountCommunities());
+}
 
-	// Random number of contacts for travelers
-	auto travelers = travelLocation.GetPeople();
-	std::for_each(std::execution::par_unseq, travelers.begin(), travelers.end(), [this](auto traveler)
-		{
-			auto numberOfContacts = Random::UniformIntRange(minTravelContacts, maxTravelContacts);
-			for (auto i = 0U; i < numberOfContacts; i++)
-			{
-				std::shared_lock<std::shared_mutex> lockTravelInfecter(travelInfecterMutex);
-				traveler->Contact(travelInfecter);
-			}
-		});
+std::vector<DiseaseSpreadSimulation::DailyRecord> DiseaseSpreadSimulation::Simulation::CountCommunities() const
+{
+	std::vector<DailyRecord> records{};
+	records.reserve(communities.size());
+	for (uint32_t index = 0U; index < communities.size(); index++)
+	{
+		const auto& community = communities[index];
+		const auto counts = community.GetPopulationStore().Count();
+		// The communities of a region are numbered by the mobility
+		const auto communityID = m_mobility != nullptr ? m_firstCommunity + index : community.GetID();
+		records.push_back({runNumber,
+			static_cast<uint32_t>(elapsedDays),
+			communityID,
+			static_cast<uint32_t>(counts.susceptible),
+			static_cast<uint32_t>(counts.exposed),
+			static_cast<uint32_t>(counts.infectious),
+			static_cast<uint32_t>(counts.recovered),
+			static_cast<uint32_t>(counts.dead),
+			static_cast<uint32_t>(counts.traveling),
+			static_cast<uint32_t>(counts.quarantined),
+			static_cast<uint32_t>(community.NumberOfPositiveTests()),
+			static_cast<uint32_t>(community.NumberOfPersonsQuarantined())});
+	}
+	return records;
 }
 
-void DiseaseSpreadSimulation::Simulation::ContactForPlace(Place& place)
+std::vector<DiseaseSpreadSimulation::DailyRecord> DiseaseSpreadSimulation::Simulation::GatherRegionCounters() const
 {
-	// Get all susceptible and infectious people
-	std::vector<Person*> susceptible{};
-	susceptible.reserve(place.GetPersonCount());
-	std::vector<Person*> infectious{};
-	infectious.reserve(place.GetPersonCount());
-	for (auto* person : place.GetPeople())
+	auto records = CountCommunities();
+	if (m_processGroup == nullptr || m_processGroup->Size() == 1U)
 	{
-		if (person->IsSusceptible())
-		{
-			susceptible.push_back(person);
-		}
-		else if (person->IsInfectious())
-		{
-			infectious.push_back(person);
-		}
+		return records;
 	}
 
-	// Every infectious person has a chance to infect a susceptible person
-	for (auto* infectiousPerson : infectious)
+	std::vector<ProcessGroup::Message> messages(m_processGroup->Size());
+	if (!IsRoot())
 	{
-		for (auto* susceptiblePerson : susceptible)
-		{
-			infectiousPerson->Contact(*susceptiblePerson);
-		}
+		messages.front() = ProcessGroup::ToMessage(records);
+	}
+	const auto received = m_processGroup->Exchange(std::move(messages));
+	if (!IsRoot())
+	{
+		return {};
+	}
+	// The ranks hold the communities in order
+	for (uint32_t rank = 1U; rank < received.size(); rank++)
+	{
+		const auto other = ProcessGroup::FromMessage<DailyRecord>(received[rank]);
+		records.insert(records.end(), other.begin(), other.end());
 	}
+	return records;
 }
 
 void DiseaseSpreadSimulation::Simulation::Print() const
 {
+	PROFILE_ZONE("Print");
 	// Only print once per hour
 	//PrintEveryHour();
 	// Only print once per day
-	if (isNewDay)
+	if (!isNewDay)
 	{
-		PrintOncePerDay();
+		return;
+	}
+
+	// Only the counters are taken here, the output stage formats and prints them while the next hour is simulated
+	std::vector<std::pair<uint32_t, PopulationCounts>> counts{};
+	counts.reserve(communities.size());
+	for (const auto& community : communities)
+	{
+		counts.emplace_back(community.GetID(), community.GetPopulationStore().Count());
 	}
+	m_output->Submit([counts = std::move(counts), day = elapsedDays, hour = time.GetTime(), digitCount = m_initialPopulationSizeDigitCount]()
+		{
+			PrintOncePerDay(counts, day, hour, digitCount);
+		});
 }
 
 void DiseaseSpreadSimulation::Simulation::PrintEveryHour() const
 {
+	FlushOutput();
 	for (const auto& community : communities)
 	{
 
 		fmt::print("\nCommunity id: {} Day: {} Time : {} o'clock\n", community.GetID(), elapsedDays, time.GetTime());
 
-		PrintPopulation(community.GetPopulation());
+		PrintPopulation(community.GetPopulationStore().Count(), m_initialPopulationSizeDigitCount);
 
 		// Print public places
 		const auto& places = community.GetPlaces();
@@ -248,68 +1397,37 @@ void DiseaseSpreadSimulation::Simulation::PrintEveryHour() const
 	}
 }
 
-void DiseaseSpreadSimulation::Simulation::PrintOncePerDay() const
+void DiseaseSpreadSimulation::Simulation::PrintOncePerDay(const std::vector<std::pair<uint32_t, PopulationCounts>>& counts, uint64_t day, uint32_t hour, uint32_t digitCount)
 {
-	for (const auto& community : communities)
+	for (const auto& [communityID, communityCounts] : counts)
 	{
-		fmt::print("\nCommunity id: {} Day: {} Time : {} o'clock\n", community.GetID(), elapsedDays, time.GetTime());
+		fmt::print("\nCommunity id: {} Day: {} Time : {} o'clock\n", communityID, day, hour);
 
-		PrintPopulation(community.GetPopulation());
+		PrintPopulation(communityCounts, digitCount);
 	}
 }
 
-void DiseaseSpreadSimulation::Simulation::PrintPopulation(const std::vector<Person>& population) const
+void DiseaseSpreadSimulation::Simulation::PrintPopulation(const PopulationCounts& counts, uint32_t digitCount)
 {
-	size_t populationCount{0};
-	size_t susceptible{0};
-	size_t withDisease{0};
-	size_t infectious{0};
-	size_t deadPeople{0};
-	size_t traveling{0};
-
-	for (const auto& person : population)
-	{
-		if (person.IsAlive())
-		{
-			++populationCount;
-
-			if (person.IsSusceptible())
-			{
-				++susceptible;
-			}
-			else
-			{
-				if (person.HasDisease())
-				{
-					++withDisease;
-
-					if (person.IsInfectious())
-					{
-						++infectious;
-					}
-				}
-			}
-			if (person.IsTraveling())
-			{
-				++traveling;
-			}
-		}
-		else
-		{
-			++deadPeople;
-		}
-	}
-
-	fmt::print("Population:   {:>{}}\t\t", populationCount, m_initialPopulationSizeDigitCount);
-	fmt::print("Susceptible: {:>{}}\n", susceptible, m_initialPopulationSizeDigitCount);
-	fmt::print("With Disease: {:>{}}\t\t", withDisease, m_initialPopulationSizeDigitCount);
-	fmt::print("Infectious:  {:>{}}\n", infectious, m_initialPopulationSizeDigitCount);
-	fmt::print("Traveling:    {:>{}}\t\t", traveling, m_initialPopulationSizeDigitCount);
-	fmt::print("Have died:   {:>{}}\n", deadPeople, m_initialPopulationSizeDigitCount);
+	const auto populationCount = counts.alive;
+	const auto susceptible = counts.susceptible;
+	const auto withDisease = counts.withDisease;
+	const auto infectious = counts.infectious;
+	const auto deadPeople = counts.dead;
+	const auto traveling = counts.traveling;
+
+	fmt::print("Population:   {:>{}}\t\t", populationCount, digitCount);
+	fmt::print("Susceptible: {:>{}}\n", susceptible, digitCount);
+	fmt::print("With Disease: {:>{}}\t\t", withDisease, digitCount);
+	fmt::print("Infectious:  {:>{}}\n", infectious, digitCount);
+	fmt::print("Traveling:    {:>{}}\t\t", traveling, digitCount);
+	fmt::print("Have died:   {:>{}}\n", deadPeople, digitCount);
 }
 
 void DiseaseSpreadSimulation::Simulation::PrintRunResult(const uint32_t days) const
 {
+	PROFILE_ZONE("Print");
+	FlushOutput();
 	// Containment measures
 	// Starting population
 	// Deaths
@@ -351,7 +1469,7 @@ void DiseaseSpreadSimulation::Simulation::PrintRunResult(const uint32_t days) co
 		fmt::print(" [{}] full lockdown", XorSpace(containmentMeasures.IsLockdown()));		
 		
 		fmt::print("\nCurrent population status:\n");
-		PrintPopulation(community.GetPopulation());
+		PrintPopulation(community.GetPopulationStore().Count(), m_initialPopulationSizeDigitCount);
 
 		fmt::print("Total infection count: {}\n", community.CurrentInfectionMax());
 		fmt::print("Positive Tests: {}\t", community.NumberOfPositiveTests());
@@ -359,6 +1477,64 @@ void DiseaseSpreadSimulation::Simulation::PrintRunResult(const uint32_t days) co
 	}
 }
 
+void DiseaseSpreadSimulation::Simulation::PrintRegionDay(uint64_t day, const std::vector<DailyRecord>& records)
+{
+	DailyRecord total{};
+	uint32_t withDisease{0U};
+	for (const auto& record : records)
+	{
+		total.susceptible += record.susceptible;
+		total.exposed += record.exposed;
+		total.infectious += record.infectious;
+		total.recovered += record.recovered;
+		total.dead += record.dead;
+		total.traveling += record.traveling;
+		if (record.exposed + record.infectious > 0U)
+		{
+			withDisease++;
+		}
+	}
+
+	fmt::print("\nRegion Day: {} Communities with disease: {} of {}\n", day, withDisease, records.size());
+	fmt::print("Susceptible: {} Exposed: {} Infectious: {} Recovered: {} Dead: {} Traveling: {}\n", total.susceptible, total.exposed, total.infectious, total.recovered, total.dead, total.traveling);
+}
+
+void DiseaseSpreadSimulation::Simulation::PrintRegionResult(uint32_t days, const std::vector<DailyRecord>& records) const
+{
+	PROFILE_ZONE("Print");
+	constexpr auto lineLength = 99U;
+	const auto& containmentMeasures = communities.front().ContainmentMeasures();
+
+	fmt::print("{:-^{}}\n", "", lineLength);
+	fmt::print("Simulation #{} simulated {} days of a region with {} communities of {} persons.\n", runNumber, days, records.size(), m_populationSize);
+	fmt::print("Every community");
+	fmt::print(" [{}] mask mandate", XorSpace(containmentMeasures.IsMaskMandate()));
+	fmt::print(" [{}] home office mandate", XorSpace(containmentMeasures.WorkingFromHome()));
+	fmt::print(" [{}] shops are closed", XorSpace(containmentMeasures.ShopsAreClosed()));
+	fmt::print(" [{}] full lockdown\n", XorSpace(containmentMeasures.IsLockdown()));
+	fmt::print("{:-^{}}\n", "", lineLength);
+
+	const auto printRow = [](const auto& name, const DailyRecord& record)
+	{
+		fmt::print("{:>9} {:>11} {:>8} {:>10} {:>9} {:>6} {:>9} {:>14} {:>19}\n", name, record.susceptible, record.exposed, record.infectious, record.recovered, record.dead, record.traveling, record.positiveTests, record.personsQuarantined);
+	};
+	fmt::print("{:>9} {:>11} {:>8} {:>10} {:>9} {:>6} {:>9} {:>14} {:>19}\n", "Community", "Susceptible", "Exposed", "Infectious", "Recovered", "Dead", "Traveling", "Positive Tests", "Persons Quarantined");
+	DailyRecord total{};
+	for (const auto& record : records)
+	{
+		printRow(record.communityID, record);
+		total.susceptible += record.susceptible;
+		total.exposed += record.exposed;
+		total.infectious += record.infectious;
+		total.recovered += record.recovered;
+		total.dead += record.dead;
+		total.traveling += record.traveling;
+		total.positiveTests += record.positiveTests;
+		total.personsQuarantined += record.personsQuarantined;
+	}
+	printRow("Total", total);
+}
+
 char DiseaseSpreadSimulation::Simulation::XorSpace(bool printX)
 {
 	if (printX)
@@ -381,7 +1557,7 @@ bool DiseaseSpreadSimulation::Simulation::CheckForNewDay()
 
 void DiseaseSpreadSimulation::Simulation::SetDiseaseContainmentMeasures(Community& community)
 {
-	static auto nextMeasure{DiseaseContainmentMeasures::Nothing};
+	auto& nextMeasure = m_nextContainmentMeasure;
 
 	auto& setContainmentMeasures = community.SetContainmentMeasures();
 	switch (nextMeasure)
@@ -427,6 +1603,8 @@ void DiseaseSpreadSimulation::Simulation::SetDiseaseContainmentMeasures(Communit
 
 void DiseaseSpreadSimulation::Simulation::SetupTravelInfecter(const Disease* disease, Community* community)
 {
+	// Derive the stream from the simulation to keep the run reproducible
+	travelInfecter.GetRandomStream() = Random::Engine{Random::Generator()()};
 	travelInfecter.Contaminate(disease);
 	travelInfecter.SetCommunity(community);
 	Home home{};
@@ -437,8 +1615,9 @@ void DiseaseSpreadSimulation::Simulation::SetupTravelInfecter(const Disease* dis
 	}
 }
 
-void DiseaseSpreadSimulation::Simulation::SetupEverything(uint32_t communityCount)
+void DiseaseSpreadSimulation::Simulation::SetupEverything(uint32_t communityCount, bool printSetup, const Community* population)
 {
+	PROFILE_ZONE("SetupEverything");
 	// Don't run the whole setup twice
 	if (isSetupDone)
 	{
@@ -446,8 +1625,7 @@ void DiseaseSpreadSimulation::Simulation::SetupEverything(uint32_t communityCoun
 		if (communityCount > communities.size())
 		{
 			auto newCommunityCount = communityCount - static_cast<uint32_t>(communities.size());
-			communities.reserve(newCommunityCount);
-			CreateCommunities(newCommunityCount);
+			CreateCommunities(newCommunityCount, population);
 		}
 		return;
 	}
@@ -461,17 +1639,21 @@ void DiseaseSpreadSimulation::Simulation::SetupEverything(uint32_t communityCoun
 		CreateDiseasesFromFile(m_diseaseFilename);
 	}
 
-	communities.reserve(communityCount);
-	CreateCommunities(communityCount);
+	CreateCommunities(communityCount, population);
 
 	// Only one travel infecter is needed
 	SetupTravelInfecter(&diseases.back(), &communities.front());
 
-	stop = false;
 	isSetupDone = true;
 
+	if (!printSetup)
+	{
+		return;
+	}
 	fmt::print("Setup complete{:^11}", '-');
-	fmt::print("{} disease and {} communities created\n", diseases.size(), communities.size());
+	// A region counts the communities of every process
+	const auto createdCount = m_mobility != nullptr ? size_t{m_mobility->CommunityCount()} : communities.size();
+	fmt::print("{} disease and {} communities created with seed {}\n", diseases.size(), createdCount, m_seed);
 
 	fmt::print("Disease created: ");
 	for (const auto& disease : diseases)
@@ -486,14 +1668,85 @@ void DiseaseSpreadSimulation::Simulation::InfectRandomPerson(const Disease* dise
 	population.at(Random::RandomVectorIndex(population)).Contaminate(disease);
 }
 
-void DiseaseSpreadSimulation::Simulation::CreateCommunities(uint32_t communityCount)
+void DiseaseSpreadSimulation::Simulation::CreateCommunities(uint32_t communityCount, const Community* population)
+{
+	if (m_mobility != nullptr)
+	{
+		CreateRegion(communityCount);
+		return;
+	}
+
+	// Persons point to their community, so the communities must not move
+	communities.reserve(communities.size() + communityCount);
+	const auto first = communities.size();
+
+	// Every community is a copy of the same population, so the containment measures are compared on the same people
+	for (auto i = 0U; i < communityCount; i++)
+	{
+		if (population != nullptr)
+		{
+			communities.emplace_back(*population);
+		}
+		else if (i == 0U)
+		{
+			CreatePopulation();
+		}
+		else
+		{
+			communities.emplace_back(communities[first]);
+		}
+	}
+
+	for (auto index = first; index < communities.size(); index++)
+	{
+		SetDiseaseContainmentMeasures(communities[index]);
+		InfectRandomPerson(&diseases.back(), communities[index].GetPopulation());
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::CreateRegion(uint32_t communityCount)
 {
+	PROFILE_ZONE("CreateRegion");
+	communities.reserve(communities.size() + communityCount);
+	const auto containmentMeasure = m_nextContainmentMeasure;
+	const auto communitySeed = Random::StreamSeed(m_seed, communityStreamID);
 	for (auto i = 0U; i < communityCount; i++)
 	{
-		communities.emplace_back(m_populationSize, m_country);
-		SetDiseaseContainmentMeasures(communities.back());
-		InfectRandomPerson(&diseases.back(), communities.back().GetPopulation());
+		// Linked communities are different towns. The stream makes a town the same in whichever process creates it.
+		const auto regionIndex = m_firstCommunity + static_cast<uint32_t>(communities.size());
+		Random::Engine stream{Random::StreamSeed(communitySeed, regionIndex)};
+		Random::StreamGuard streamGuard(stream);
+		auto& community = communities.emplace_back(m_populationSize, m_country, m_pool);
+
+		// A region shares its containment measure and starts with one infection
+		m_nextContainmentMeasure = containmentMeasure;
+		SetDiseaseContainmentMeasures(community);
+		if (regionIndex == 0U)
+		{
+			InfectRandomPerson(&diseases.back(), community.GetPopulation());
+		}
+	}
+}
+
+void DiseaseSpreadSimulation::Simulation::CreatePopulation()
+{
+	PROFILE_ZONE("CreatePopulation");
+	if (m_populationCache == nullptr)
+	{
+		communities.emplace_back(m_populationSize, m_country, m_pool);
+		return;
+	}
+
+	// Loading draws from the stream as well, so both leave our stream alone
+	Random::Engine populationStream{Random::StreamSeed(m_seed, populationStreamID)};
+	Random::StreamGuard streamGuard(populationStream);
+	if (auto cached = m_populationCache->Find(m_populationSize, m_country, m_seed))
+	{
+		communities.emplace_back(*cached, m_country);
+		return;
 	}
+	communities.emplace_back(m_populationSize, m_country, m_pool);
+	m_populationCache->Store(communities.back().CachePopulation(), m_populationSize, m_country, m_seed);
 }
 
 void DiseaseSpreadSimulation::Simulation::ResetCommunities()
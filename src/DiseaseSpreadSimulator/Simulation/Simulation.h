@@ -1,63 +1,208 @@
 #pragma once
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <string>
 #include <shared_mutex>
+#include <span>
+#include <utility>
 #include "Enums.h"
 #include "Simulation/TimeManager.h"
+#include "Simulation/TimeSeries.h"
+#include "Simulation/PopulationCache.h"
+#include "Simulation/Mobility.h"
+#include "Simulation/OutputStage.h"
+#include "Simulation/ThreadPool.h"
+#include "Simulation/TaskGraph.h"
 #include "Person/Person.h"
 #include "Disease/Disease.h"
 #include "Places/Community.h"
+#include "RandomNumbers.h"
 
 namespace DiseaseSpreadSimulation
 {
+	class ProcessGroup;
+
 	class Simulation
 	{
 	public:
-		explicit Simulation(uint64_t populationSize, bool withPrint, const std::string& diseaseFilename, Country country);
+		// State of a community at the end of a run
+		struct RunResult
+		{
+			DiseaseContainmentMeasures containmentMeasure{DiseaseContainmentMeasures::Nothing};
+			PopulationCounts counts{};
+			size_t positiveTests{0U};
+			size_t personsQuarantined{0U};
+		};
+
+		explicit Simulation(uint64_t populationSize, bool withPrint, const std::string& diseaseFilename, Country country, uint64_t seed = Random::GetSeed(), Contact_Model contactModel = Contact_Model::Aggregated);
 
+		// Runs until Stop is called
 		void Run();
-		// Will run the simulation for the stated days and print a result after
+		// Will run the simulation for the stated days and print a result after. A stopped run prints the days it has simulated.
 		void RunForDays(uint32_t days);
 		void CompareContainmentMeasures(uint32_t runDays, uint32_t numberOfRuns = 1U);
+		// Can be called from any thread while the simulation runs. Every run and step checks them between two hours.
+		// A region split over several processes only checks them at the start of a day and stops when any of its processes stops. A paused simulation sleeps until it is resumed or stopped.
+		// A stopped simulation doesn't simulate any more hours until its run state is reset.
 		void Stop();
 		void Pause();
 		void Resume();
+		// Lets a stopped or paused simulation run again. It continues from the hour it stopped at.
+		// Call it only while no run or step is in progress.
+		void ResetRunState();
+		// Steps without printing a result. Sets up one community first when needed. Return the simulated hours,
+		// which are fewer than asked for when the simulation was stopped.
+		uint64_t AdvanceHours(uint64_t hours);
+		// Runs until the day has started
+		uint64_t RunUntilDay(uint64_t day);
+		// Runs until the summed counters of our communities meet the condition, which is checked before the first and after every hour.
+		// Returns false when maxHours have passed or the simulation was stopped before.
+		// Throws std::runtime_error for a region split over several processes, which would see different counters.
+		bool RunUntil(const std::function<bool(const PopulationCounts& counts)>& condition, uint64_t maxHours = std::numeric_limits<uint64_t>::max());
+		// Not synchronized with a run on another thread
+		[[nodiscard]] uint64_t GetElapsedHours() const;
 		void CreateCommunity(bool maskMandate = false, bool homeOffice = false, bool closeShops = false, bool lockdown = false);
+		// Simulate the next hour without printing a result. Sets up one community first when needed.
+		void RunOneHour();
+		// Run a single community with the containment measure for the days without printing anything.
+		// The community starts as a copy of the population when one is given instead of building its own.
+		RunResult RunScenario(uint32_t days, DiseaseContainmentMeasures containmentMeasure, const Community* population = nullptr);
+		// Store the whole state in a binary file. A loaded snapshot continues exactly like the saved simulation would,
+		// so the next run keeps the run number of the snapshot. A region needs its mobility to be set before loading.
+		// Both throw std::runtime_error when the file can't be used or the region is split over several processes.
+		void SaveSnapshot(const std::string& filename) const;
+		void LoadSnapshot(const std::string& filename);
+		// Append the counters of every community to the sink at the start of each day. The sink has to outlive the simulation.
+		void SetTimeSeriesSink(TimeSeriesSink* sink);
+		// Load the population from the cache instead of creating it and store it when it is missing. The cache has to outlive the simulation.
+		// A cached population is created from its own stream of the seed, so every run starts with the same population.
+		void SetPopulationCache(const PopulationCache* cache);
+		// Link the communities to one region. Travelers visit the linked communities instead of meeting the travel infecter
+		// and every community is updated by its own chain of tasks of the pool. Everything has to outlive the simulation.
+		// With a process group every process runs its own block of the communities. Only the visitors, the results of
+		// their visits and the daily counters are sent between the processes. Rank 0 prints and appends the time series.
+		void SetMobility(const MobilityMatrix* mobility, ThreadPool* pool, ProcessGroup* processGroup = nullptr);
+		// Update the communities on the pool. Every hour is one task graph, in which every community updates its persons,
+		// evaluates its places and spreads the infections in chunks without waiting for the other communities.
+		// The result is the same as without a pool. The pool has to outlive the simulation.
+		void SetThreadPool(ThreadPool* pool);
+		// Run one community for every community of the mobility with the same containment measure and print a result after.
+		// Only the first community starts with an infection, the others get it from the travelers.
+		// Every community is created from its own stream, so the result does not depend on the number of processes.
+		void RunRegion(uint32_t days, DiseaseContainmentMeasures containmentMeasure = DiseaseContainmentMeasures::Nothing);
+
+		// An infection found while the contacts were evaluated. Applied after every contact was evaluated.
+		struct InfectionEvent
+		{
+			Person* spreader;
+			Person* infected;
+		};
+		// Evaluate the contacts between the occupants of a place and collect the infections. The occupants are indices into the population.
+		// Changes only the random streams of the susceptible people.
+		static void CollectInfections(std::vector<Person>& population, std::span<const uint32_t> occupants, Contact_Model contactModel, std::vector<InfectionEvent>& events);
 
 	private:
+		enum class RunState : uint8_t
+		{
+			Running,
+			Paused,
+			Stopped
+		};
+		// Sleeps while paused. Returns false when stopped.
+		bool ContinueRun();
+		// Every process of a split region has to leave at the same hour, or the others wait for it inside Exchange forever.
+		// So they only decide at the start of a day and together. Same as ContinueRun for a region in one process.
+		bool ContinueRegionRun(uint64_t hour);
+		// Counts a new run unless a loaded run is continued
+		void StartRun();
+		[[nodiscard]] PopulationCounts CountPopulation() const;
+
 		void SetupTravelInfecter(const Disease* disease, Community* community);
-		void SetupEverything(uint32_t communityCount);
+		void SetupEverything(uint32_t communityCount, bool printSetup = true, const Community* population = nullptr);
 		static void InfectRandomPerson(const Disease* disease, std::vector<Person>& population);
-		void CreateCommunities(uint32_t communityCount);
+		// Builds one population and copies it into every community unless a population is given to copy
+		void CreateCommunities(uint32_t communityCount, const Community* population = nullptr);
+		// Adds a community with a new population or the one of the cache
+		void CreatePopulation();
 		void ResetCommunities();
 		void ResetElapsedTime();
 		void CreateDisease(bool testDisease = false);
 		void CreateDiseasesFromFile(const std::string& filename); // cppcheck-suppress unusedPrivateFunction
 
 		void Update();
-		void UpdatePopulation(std::vector<Person>& population);
+		// Every step of the hour of the community one after another
+		void UpdateCommunity(uint32_t communityIndex);
+		// Steps of the hour of one community. The persons, places and infections are split into chunks,
+		// which can be run side by side. A single chunk is everything.
+		void BeginPopulationUpdate(uint32_t communityIndex);
+		void UpdatePersons(uint32_t communityIndex, size_t chunk, size_t chunkCount);
+		// The moves of the persons are chunked by place, so no place is changed by two chunks
+		void PrepareTransfers(uint32_t communityIndex);
+		void LeavePlaces(uint32_t communityIndex, size_t chunk, size_t chunkCount);
+		void ArriveAtPlaces(uint32_t communityIndex, size_t chunk, size_t chunkCount);
+		void FinishPopulationUpdate(uint32_t communityIndex);
+		// Fills the place table of the community, which the contacts are read from
+		void IndexPlaces(uint32_t communityIndex, size_t chunk, size_t chunkCount);
+		void CollectPlaceInfections(uint32_t communityIndex, size_t chunk, size_t chunkCount);
+		void CollectTravelInfections(uint32_t communityIndex);
+		void SpreadDisease(uint32_t communityIndex, size_t chunk, size_t chunkCount);
+		void SpreadTravelInfections(uint32_t communityIndex);
+		// Begin and end of the chunk of count elements
+		static std::pair<size_t, size_t> ChunkRange(size_t count, size_t chunk, size_t chunkCount);
+		// The steps of every community as one parallel region on the pool
+		void RunHourGraph();
+		// Chunks every step into one task per thread of the pool
+		void BuildHourGraph();
+		// Every community on its own chain of tasks. First the communities are updated and send their travelers,
+		// then every community evaluates the contacts of its visitors and the results are sent back.
+		void UpdateRegion();
+		void SendTravelers(uint32_t communityIndex);
+		// Collect the visitors of our communities from our sources and the other processes
+		void HandOverVisitors();
+		void VisitCommunity(uint32_t communityIndex);
+		// Send the results to the processes of the visitors and apply ours
+		void HandBackVisitResults();
+		void ApplyVisitResult(const VisitResult& result);
+		// Adds the communities of our block with their own populations
+		void CreateRegion(uint32_t communityCount);
+		// The first community and the end of the block of the rank
+		[[nodiscard]] std::pair<uint32_t, uint32_t> RegionBlock(uint32_t rank) const;
+		[[nodiscard]] uint32_t RankOfCommunity(uint32_t regionIndex) const;
+		// Only the first process prints and writes
+		[[nodiscard]] bool IsRoot() const;
 
-		void Contacts(Places& places, Travel& travelLocation);
-		static void ContactForPlace(Place& place);
+		void AppendTimeSeries() const;
+		[[nodiscard]] std::vector<DailyRecord> CountCommunities() const;
+		// The counters of every process at rank 0. Every other rank gets nothing.
+		[[nodiscard]] std::vector<DailyRecord> GatherRegionCounters() const;
 
+		// Hands the output of the hour to the output stage
 		void Print() const;
+		// Wait for the output stage before printing anything else
+		void FlushOutput() const;
 		// Very verbose printing. Should only be used for debugging
 		void PrintEveryHour() const; // cppcheck-suppress unusedPrivateFunction
-		void PrintOncePerDay() const;
-		void PrintPopulation(const std::vector<Person>& population) const;
+		// Run on the output stage with the counters of every community
+		static void PrintOncePerDay(const std::vector<std::pair<uint32_t, PopulationCounts>>& counts, uint64_t day, uint32_t hour, uint32_t digitCount);
+		static void PrintPopulation(const PopulationCounts& counts, uint32_t digitCount);
 		void PrintRunResult(const uint32_t days) const;
+		static void PrintRegionDay(uint64_t day, const std::vector<DailyRecord>& records);
+		void PrintRegionResult(uint32_t days, const std::vector<DailyRecord>& records) const;
 		// Return X when true and a space when false
 		static char XorSpace(bool printX);
 
 		bool CheckForNewDay();
 
-		static void SetDiseaseContainmentMeasures(Community& community);
+		// Every new community gets the next containment measure
+		void SetDiseaseContainmentMeasures(Community& community);
 
 	private:
 		bool m_withPrint{false};
-		bool stop{true};
-		bool pause{false};
+		std::atomic<RunState> m_runState{RunState::Running};
 		bool isSetupDone{false};
 
 		const Country m_country{};
@@ -71,7 +216,33 @@ namespace DiseaseSpreadSimulation
 		Person travelInfecter;
 		static constexpr auto minTravelContacts{0U};
 		static constexpr auto maxTravelContacts{5U};
-		mutable std::shared_mutex travelInfecterMutex{};
+		// For every community one list of infections for every place and one for the travel location
+		std::vector<std::vector<std::vector<InfectionEvent>>> m_infectionEvents{};
+		const MobilityMatrix* m_mobility{nullptr};
+		ThreadPool* m_pool{nullptr};
+		TravelExchange m_travelExchange{};
+		ProcessGroup* m_processGroup{nullptr};
+		// Index of our first community inside the region
+		uint32_t m_firstCommunity{0U};
+		// Visitors of every community of ours and what happened to them
+		std::vector<std::vector<Visitor>> m_visitors{};
+		std::vector<std::vector<VisitResult>> m_visitResults{};
+		// Streams of the tasks on the pool. Derived from the seed and the hour, so there is nothing to save.
+		static constexpr uint64_t taskStreamID{2U};
+		uint64_t m_hourSeed{0U};
+		// Built for the number of communities it was run with last
+		TaskGraph m_hourGraph{};
+		size_t m_hourGraphCommunityCount{0U};
+		// What the steps of a community share during an hour
+		struct CommunityHour
+		{
+			bool isEveryoneDue{false};
+			// The persons that are updated when not everyone is due. Owned by the scheduler of the community.
+			const std::vector<uint32_t>* due{nullptr};
+		};
+		std::vector<CommunityHour> m_communityHours{};
+		// Every community of a region is created from its own stream
+		static constexpr uint64_t communityStreamID{3U};
 		mutable std::shared_mutex runNumberMutex{};
 		mutable std::shared_mutex communitiesMutex{};
 
@@ -81,6 +252,19 @@ namespace DiseaseSpreadSimulation
 		bool isNewDay{false};
 
 		uint32_t runNumber{};
+		// The next run continues the run of the loaded snapshot
+		bool m_continuesLoadedRun{false};
+		// Every serial random decision of the simulation is drawn from this stream. Persons have their own.
+		uint64_t m_seed{};
+		Random::Engine m_randomStream;
+		const Contact_Model m_contactModel{Contact_Model::Aggregated};
+		TimeSeriesSink* m_timeSeries{nullptr};
+		const PopulationCache* m_populationCache{nullptr};
+		// Stream of the seed from which cached populations are created
+		static constexpr uint64_t populationStreamID{1U};
+		DiseaseContainmentMeasures m_nextContainmentMeasure{DiseaseContainmentMeasures::Nothing};
 		static constexpr uint32_t DiseaseContainmentMeasuresEnumSizePlusBase{5U};
+		// Only created when printing
+		std::unique_ptr<OutputStage> m_output{};
 	};
 } // namespace DiseaseSpreadSimulation
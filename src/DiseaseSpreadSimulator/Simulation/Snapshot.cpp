@@ -0,0 +1,86 @@
+#include "Simulation/Snapshot.h"
+#include <algorithm>
+#include <stdexcept>
+
+DiseaseSpreadSimulation::BinaryWriter::BinaryWriter(std::ostream& stream)
+	: m_stream(stream)
+{
+}
+
+void DiseaseSpreadSimulation::BinaryWriter::Write(const std::string& value)
+{
+	Write(uint64_t{value.size()});
+	m_stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+DiseaseSpreadSimulation::BinaryReader::BinaryReader(std::istream& stream)
+	: m_stream(stream)
+{
+	if (const auto position = m_stream.tellg(); position >= 0)
+	{
+		m_stream.seekg(0, std::ios::end);
+		m_end = m_stream.tellg();
+		m_stream.seekg(position);
+	}
+}
+
+bool DiseaseSpreadSimulation::BinaryReader::ReadBool()
+{
+	const auto value = Read<uint8_t>();
+	if (value > 1U)
+	{
+		throw std::runtime_error("Snapshot contains an invalid bool!");
+	}
+	return value == 1U;
+}
+
+std::string DiseaseSpreadSimulation::BinaryReader::ReadString()
+{
+	const auto size = Read<uint64_t>();
+	std::string value{};
+	// Read in chunks so a broken size can't make us allocate everything at once
+	static constexpr uint64_t chunkSize{4096U};
+	for (uint64_t readSize = 0U; readSize < size; readSize += chunkSize)
+	{
+		const auto currentSize = value.size();
+		const auto toRead = std::min(chunkSize, size - readSize);
+		value.resize(currentSize + toRead);
+		m_stream.read(value.data() + currentSize, static_cast<std::streamsize>(toRead));
+		CheckStream();
+	}
+	return value;
+}
+
+uint32_t DiseaseSpreadSimulation::BinaryReader::ReadIndex(size_t size)
+{
+	const auto index = Read<uint32_t>();
+	if (index != Snapshot::noIndex && index >= size)
+	{
+		throw std::runtime_error("Snapshot contains an index out of range!");
+	}
+	return index;
+}
+
+uint32_t DiseaseSpreadSimulation::BinaryReader::ReadCount(size_t itemSize)
+{
+	const auto count = Read<uint32_t>();
+	if (m_end < 0)
+	{
+		return count;
+	}
+	const auto position = m_stream.tellg();
+	const auto bytesLeft = static_cast<uint64_t>(std::max(m_end - static_cast<std::streamoff>(position), std::streamoff{0}));
+	if (position < 0 || uint64_t{count} * itemSize > bytesLeft)
+	{
+		throw std::runtime_error("Snapshot contains more items than it has bytes left!");
+	}
+	return count;
+}
+
+void DiseaseSpreadSimulation::BinaryReader::CheckStream() const
+{
+	if (!m_stream)
+	{
+		throw std::runtime_error("Snapshot ended early!");
+	}
+}
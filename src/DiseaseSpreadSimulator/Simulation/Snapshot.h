@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace DiseaseSpreadSimulation
+{
+	// Binary snapshot of a simulation. Values are stored in the byte order of the machine.
+	namespace Snapshot
+	{
+		// "DSSS" in little endian
+		static constexpr uint32_t magic{0x53535344U};
+		// Increase when the layout changes. Older snapshots are rejected.
+		static constexpr uint32_t version{2U};
+		// Stored instead of an index when there is nothing to point to
+		static constexpr uint32_t noIndex{std::numeric_limits<uint32_t>::max()};
+	} // namespace Snapshot
+
+	class BinaryWriter
+	{
+	public:
+		explicit BinaryWriter(std::ostream& stream);
+
+		template <typename T>
+		void Write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be written");
+			m_stream.write(reinterpret_cast<const char*>(&value), sizeof(T)); // NOLINT(*-reinterpret-cast)
+		}
+		void Write(const std::string& value);
+
+	private:
+		std::ostream& m_stream;
+	};
+
+	// Throws std::runtime_error when the stream ends early or holds values that can't be valid
+	class BinaryReader
+	{
+	public:
+		explicit BinaryReader(std::istream& stream);
+
+		template <typename T>
+		T Read()
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be read");
+			T value{};
+			m_stream.read(reinterpret_cast<char*>(&value), sizeof(T)); // NOLINT(*-reinterpret-cast)
+			CheckStream();
+			return value;
+		}
+		// Read a bool and throw when its byte is neither 0 nor 1
+		bool ReadBool();
+		// Read an enum and throw when it is not between the first value and the max value
+		template <typename T>
+		requires std::is_enum_v<T>
+		T ReadEnum(T maxValue)
+		{
+			using Underlying = std::underlying_type_t<T>;
+			const auto value = Read<Underlying>();
+			if constexpr (std::is_signed_v<Underlying>)
+			{
+				if (value < 0)
+				{
+					throw std::runtime_error("Snapshot contains an unknown enum value!");
+				}
+			}
+			if (value > static_cast<Underlying>(maxValue))
+			{
+				throw std::runtime_error("Snapshot contains an unknown enum value!");
+			}
+			return static_cast<T>(value);
+		}
+		std::string ReadString();
+		// Read an index and throw when it is not below the size. Snapshot::noIndex is passed through.
+		uint32_t ReadIndex(size_t size);
+		// Read a count of items that take at least itemSize bytes each and throw when the rest of the stream can't hold them.
+		// Checked before anything is reserved for the items.
+		uint32_t ReadCount(size_t itemSize);
+
+	private:
+		void CheckStream() const;
+
+		std::istream& m_stream;
+		// End of the stream or -1 when the stream can't seek
+		std::streamoff m_end{-1};
+	};
+} // namespace DiseaseSpreadSimulation
@@ -0,0 +1,68 @@
+#include "Simulation/TaskGraph.h"
+#include <stdexcept>
+#include <utility>
+#include "fmt/format.h"
+
+DiseaseSpreadSimulation::TaskGraph::TaskID DiseaseSpreadSimulation::TaskGraph::Add(std::function<void()> work, const std::vector<TaskID>& dependencies)
+{
+	const auto id = static_cast<TaskID>(m_tasks.size());
+	for (const auto dependency : dependencies)
+	{
+		if (dependency >= id)
+		{
+			throw std::out_of_range(fmt::format("Task {} depends on task {}, which is not added yet!", id, dependency));
+		}
+		m_tasks[dependency].dependents.push_back(id);
+	}
+	m_tasks.push_back({std::move(work), {}, static_cast<uint32_t>(dependencies.size())});
+	m_remaining.reset();
+	return id;
+}
+
+void DiseaseSpreadSimulation::TaskGraph::Clear()
+{
+	m_tasks.clear();
+	m_remaining.reset();
+}
+
+size_t DiseaseSpreadSimulation::TaskGraph::TaskCount() const
+{
+	return m_tasks.size();
+}
+
+void DiseaseSpreadSimulation::TaskGraph::Run(ThreadPool& pool)
+{
+	if (!m_remaining)
+	{
+		m_remaining = std::make_unique<std::atomic<uint32_t>[]>(m_tasks.size());
+	}
+	for (size_t id = 0; id < m_tasks.size(); id++)
+	{
+		m_remaining[id] = m_tasks[id].dependencyCount;
+	}
+	for (TaskID id = 0U; id < m_tasks.size(); id++)
+	{
+		if (m_tasks[id].dependencyCount == 0U)
+		{
+			Submit(pool, id);
+		}
+	}
+	pool.Wait();
+}
+
+void DiseaseSpreadSimulation::TaskGraph::Submit(ThreadPool& pool, TaskID id)
+{
+	pool.Submit([this, &pool, id]()
+		{
+			const auto& task = m_tasks[id];
+			task.work();
+			// The last dependency to finish submits the task. It stays on the queue of this worker.
+			for (const auto dependent : task.dependents)
+			{
+				if (m_remaining[dependent].fetch_sub(1U) == 1U)
+				{
+					Submit(pool, dependent);
+				}
+			}
+		});
+}
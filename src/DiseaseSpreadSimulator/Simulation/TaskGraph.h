@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Simulation/ThreadPool.h"
+
+namespace DiseaseSpreadSimulation
+{
+	// Tasks of one parallel region with the tasks they depend on. A task is submitted to the pool as soon as the last
+	// of its dependencies is done, so independent chains of tasks never wait for each other at a barrier.
+	// Built once and run as often as needed.
+	class TaskGraph
+	{
+	public:
+		using TaskID = uint32_t;
+
+		// Dependencies have to be added before their dependents
+		TaskID Add(std::function<void()> work, const std::vector<TaskID>& dependencies = {});
+		void Clear();
+		[[nodiscard]] size_t TaskCount() const;
+
+		// Block until every task is done and rethrow the first exception of a task.
+		// The dependents of a task that has thrown are not run.
+		void Run(ThreadPool& pool);
+
+	private:
+		struct Task
+		{
+			std::function<void()> work;
+			std::vector<TaskID> dependents{};
+			uint32_t dependencyCount{0U};
+		};
+
+		void Submit(ThreadPool& pool, TaskID id);
+
+		std::vector<Task> m_tasks{};
+		// Dependencies that are not done yet for every task of the current run
+		std::unique_ptr<std::atomic<uint32_t>[]> m_remaining{};
+	};
+} // namespace DiseaseSpreadSimulation
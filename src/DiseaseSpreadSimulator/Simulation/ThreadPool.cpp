@@ -0,0 +1,175 @@
+#include "Simulation/ThreadPool.h"
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+	// The pool and the index of the worker running on this thread
+	thread_local const DiseaseSpreadSimulation::ThreadPool* currentPool{nullptr};
+	thread_local size_t currentWorker{0U};
+} // namespace
+
+DiseaseSpreadSimulation::ThreadPool::ThreadPool(size_t threadCount)
+{
+	threadCount = std::max<size_t>(threadCount, 1U);
+	m_workers.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		m_workers.push_back(std::make_unique<Worker>());
+	}
+	m_threads.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		m_threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+}
+
+DiseaseSpreadSimulation::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lockState(m_stateMutex);
+		m_stop = true;
+	}
+	m_wakeWorkers.notify_all();
+	for (auto& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+void DiseaseSpreadSimulation::ThreadPool::Submit(std::function<void()> task)
+{
+	// Workers keep their tasks, everybody else spreads them over the workers
+	const auto index = currentPool == this ? currentWorker : m_nextWorker++ % m_workers.size();
+	++m_pending;
+	{
+		// Count first, so the count never drops below the tasks inside the queues.
+		// Taking the lock makes sure a worker that is about to sleep sees the task.
+		std::lock_guard lockState(m_stateMutex);
+		++m_queued;
+	}
+	{
+		auto& worker = *m_workers[index];
+		std::lock_guard lockWorker(worker.mutex);
+		worker.tasks.push_back(std::move(task));
+	}
+	m_wakeWorkers.notify_one();
+}
+
+void DiseaseSpreadSimulation::ThreadPool::Wait()
+{
+	if (currentPool == this)
+	{
+		// The waiting tasks are pending themselves. Done when nothing else is left.
+		++m_waiting;
+		while (m_pending > m_waiting)
+		{
+			if (!TryRunTask(currentWorker))
+			{
+				std::this_thread::yield();
+			}
+		}
+		--m_waiting;
+	}
+	else
+	{
+		std::unique_lock lockState(m_stateMutex);
+		m_allDone.wait(lockState, [this]()
+			{
+				return m_pending == 0U;
+			});
+	}
+
+	std::lock_guard lockState(m_stateMutex);
+	if (m_exception != nullptr)
+	{
+		std::rethrow_exception(std::exchange(m_exception, nullptr));
+	}
+}
+
+size_t DiseaseSpreadSimulation::ThreadPool::ThreadCount() const
+{
+	return m_threads.size();
+}
+
+void DiseaseSpreadSimulation::ThreadPool::WorkerLoop(size_t index)
+{
+	currentPool = this;
+	currentWorker = index;
+
+	while (true)
+	{
+		if (TryRunTask(index))
+		{
+			continue;
+		}
+
+		std::unique_lock lockState(m_stateMutex);
+		m_wakeWorkers.wait(lockState, [this]()
+			{
+				return m_stop || m_queued > 0U;
+			});
+		if (m_stop && m_queued == 0U)
+		{
+			return;
+		}
+	}
+}
+
+bool DiseaseSpreadSimulation::ThreadPool::TryRunTask(size_t index)
+{
+	std::function<void()> task{};
+
+	// Newest task of our own queue first
+	{
+		auto& worker = *m_workers[index];
+		std::lock_guard lockWorker(worker.mutex);
+		if (!worker.tasks.empty())
+		{
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+		}
+	}
+
+	// Steal the oldest task of the next worker with work
+	for (size_t offset = 1U; !task && offset < m_workers.size(); offset++)
+	{
+		auto& victim = *m_workers[(index + offset) % m_workers.size()];
+		std::lock_guard lockVictim(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+		}
+	}
+
+	if (!task)
+	{
+		return false;
+	}
+	--m_queued;
+	RunTask(task);
+	return true;
+}
+
+void DiseaseSpreadSimulation::ThreadPool::RunTask(std::function<void()>& task)
+{
+	try
+	{
+		task();
+	}
+	catch (...)
+	{
+		std::lock_guard lockState(m_stateMutex);
+		if (m_exception == nullptr)
+		{
+			m_exception = std::current_exception();
+		}
+	}
+
+	if (--m_pending == 0U)
+	{
+		std::lock_guard lockState(m_stateMutex);
+		m_allDone.notify_all();
+	}
+}
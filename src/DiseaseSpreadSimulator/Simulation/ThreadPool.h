@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DiseaseSpreadSimulation
+{
+	// Work stealing thread pool. Every worker has its own queue and takes the newest task from it.
+	// Idle workers steal the oldest task of another worker. Tasks submitted by a worker stay in its queue.
+	class ThreadPool
+	{
+	public:
+		explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency());
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool(ThreadPool&&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		ThreadPool& operator=(ThreadPool&&) = delete;
+		~ThreadPool();
+
+		void Submit(std::function<void()> task);
+		// Block until every submitted task is done and rethrow the first exception of a task.
+		// A task that waits runs other tasks meanwhile and returns when only waiting tasks are left.
+		void Wait();
+
+		[[nodiscard]] size_t ThreadCount() const;
+
+	private:
+		struct Worker
+		{
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks{};
+		};
+
+		void WorkerLoop(size_t index);
+		// Run one task of our own queue or steal one. Returns false when every queue was empty.
+		bool TryRunTask(size_t index);
+		void RunTask(std::function<void()>& task);
+
+		std::vector<std::unique_ptr<Worker>> m_workers{};
+		std::vector<std::thread> m_threads{};
+		// Tasks inside the queues
+		std::atomic<size_t> m_queued{0U};
+		// Tasks that are not finished yet
+		std::atomic<size_t> m_pending{0U};
+		// Tasks inside Wait
+		std::atomic<size_t> m_waiting{0U};
+		std::atomic<size_t> m_nextWorker{0U};
+		std::exception_ptr m_exception{};
+
+		std::mutex m_stateMutex;
+		std::condition_variable m_wakeWorkers;
+		std::condition_variable m_allDone;
+		bool m_stop{false};
+	};
+} // namespace DiseaseSpreadSimulation
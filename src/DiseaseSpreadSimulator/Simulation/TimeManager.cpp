@@ -47,3 +47,19 @@ DiseaseSpreadSimulation::Day DiseaseSpreadSimulation::TimeManager::GetNextDay()
 	}
 	return static_cast<Day>(static_cast<int>(currentDay) + 1);
 }
+
+void DiseaseSpreadSimulation::TimeManager::Save(BinaryWriter& writer) const
+{
+	writer.Write(simulationTime);
+	writer.Write(currentDay);
+	writer.Write(isWorkday);
+	writer.Write(dayTime);
+}
+
+void DiseaseSpreadSimulation::TimeManager::Load(BinaryReader& reader)
+{
+	simulationTime = reader.Read<uint64_t>();
+	currentDay = reader.ReadEnum(Day::Sunday);
+	isWorkday = reader.ReadBool();
+	dayTime = reader.Read<uint32_t>();
+}
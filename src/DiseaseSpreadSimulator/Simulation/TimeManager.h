@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include "Enums.h"
+#include "Simulation/Snapshot.h"
 
 namespace DiseaseSpreadSimulation
 {
@@ -21,6 +22,9 @@ namespace DiseaseSpreadSimulation
 		// Get the time in 24h format
 		[[nodiscard]] uint32_t GetTime() const;
 
+		void Save(BinaryWriter& writer) const;
+		void Load(BinaryReader& reader);
+
 	private:
 		[[nodiscard]] Day GetNextDay() const;
 
@@ -0,0 +1,199 @@
+#include "Simulation/TimeSeries.h"
+#include <iterator>
+#include <string>
+#include <stdexcept>
+#include <string_view>
+#include "fmt/format.h"
+
+namespace
+{
+	// Columnar files store every value in little endian, whatever the byte order of the host is
+	void AppendLittleEndian(std::string& buffer, uint32_t value)
+	{
+		for (uint32_t byte = 0U; byte < sizeof(value); byte++)
+		{
+			buffer.push_back(static_cast<char>((value >> (byte * 8U)) & 0xFFU));
+		}
+	}
+} // namespace
+
+DiseaseSpreadSimulation::TimeSeriesSink::TimeSeriesSink(const std::string& filename, Format format)
+	: m_file(filename, std::ios::binary | std::ios::trunc),
+	  m_format(format)
+{
+	if (!m_file)
+	{
+		throw std::runtime_error(fmt::format("Can't open {} to write the time series!", filename));
+	}
+	WriteHeader();
+	if (!m_file.flush())
+	{
+		throw std::runtime_error(fmt::format("Can't write the time series to {}!", filename));
+	}
+	m_writer = std::thread(&TimeSeriesSink::WriterLoop, this);
+}
+
+DiseaseSpreadSimulation::TimeSeriesSink::~TimeSeriesSink()
+{
+	StopWriter();
+}
+
+void DiseaseSpreadSimulation::TimeSeriesSink::Append(std::vector<DailyRecord> records)
+{
+	if (records.empty())
+	{
+		return;
+	}
+	{
+		std::lock_guard lockBatches(m_mutex);
+		m_batches.push_back(std::move(records));
+	}
+	m_hasWork.notify_one();
+}
+
+void DiseaseSpreadSimulation::TimeSeriesSink::Flush()
+{
+	std::unique_lock lockBatches(m_mutex);
+	m_idle.wait(lockBatches, [this]()
+		{
+			return m_batches.empty() && !m_writing;
+		});
+	if (m_failed)
+	{
+		throw std::runtime_error("Failed to write the time series!");
+	}
+}
+
+void DiseaseSpreadSimulation::TimeSeriesSink::Close()
+{
+	StopWriter();
+	if (m_file.is_open())
+	{
+		m_file.close();
+	}
+	if (m_failed || m_file.fail())
+	{
+		throw std::runtime_error("Failed to write the time series!");
+	}
+}
+
+void DiseaseSpreadSimulation::TimeSeriesSink::StopWriter()
+{
+	if (!m_writer.joinable())
+	{
+		return;
+	}
+	{
+		std::lock_guard lockBatches(m_mutex);
+		m_stop = true;
+	}
+	m_hasWork.notify_one();
+	m_writer.join();
+}
+
+DiseaseSpreadSimulation::TimeSeriesSink::Format DiseaseSpreadSimulation::TimeSeriesSink::FormatFromFilename(const std::string& filename)
+{
+	static constexpr std::string_view csvExtension{".csv"};
+	if (filename.size() >= csvExtension.size() && filename.compare(filename.size() - csvExtension.size(), csvExtension.size(), csvExtension) == 0)
+	{
+		return Format::Csv;
+	}
+	return Format::Columnar;
+}
+
+void DiseaseSpreadSimulation::TimeSeriesSink::WriterLoop()
+{
+	std::vector<DailyRecord> records{};
+	while (true)
+	{
+		{
+			std::unique_lock lockBatches(m_mutex);
+			m_writing = false;
+			if (m_batches.empty())
+			{
+				m_idle.notify_all();
+			}
+			m_hasWork.wait(lockBatches, [this]()
+				{
+					return m_stop || !m_batches.empty();
+				});
+			if (m_batches.empty())
+			{
+				return;
+			}
+
+			// Take everything that has piled up as one batch
+			records.clear();
+			for (auto& batch : m_batches)
+			{
+				records.insert(records.end(), batch.begin(), batch.end());
+			}
+			m_batches.clear();
+			m_writing = true;
+		}
+
+		// Flushed right away, so a full disk is noticed by the next Flush and not only when the file is closed
+		WriteBatch(records);
+		if (!m_file.flush())
+		{
+			std::lock_guard lockBatches(m_mutex);
+			m_failed = true;
+		}
+	}
+}
+
+void DiseaseSpreadSimulation::TimeSeriesSink::WriteHeader()
+{
+	if (m_format == Format::Csv)
+	{
+		for (size_t column = 0; column < columns.size(); column++)
+		{
+			m_file << (column == 0U ? "" : ",") << columns.at(column).first;
+		}
+		m_file << '\n';
+		return;
+	}
+
+	std::string header{};
+	AppendLittleEndian(header, magic);
+	AppendLittleEndian(header, version);
+	AppendLittleEndian(header, static_cast<uint32_t>(columns.size()));
+	for (const auto& column : columns)
+	{
+		const std::string_view name{column.first};
+		AppendLittleEndian(header, static_cast<uint32_t>(name.size()));
+		header.append(name);
+	}
+	m_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+}
+
+void DiseaseSpreadSimulation::TimeSeriesSink::WriteBatch(const std::vector<DailyRecord>& records)
+{
+	m_buffer.clear();
+
+	if (m_format == Format::Csv)
+	{
+		auto output = std::back_inserter(m_buffer);
+		for (const auto& record : records)
+		{
+			for (size_t column = 0; column < columns.size(); column++)
+			{
+				fmt::format_to(output, "{}{}", column == 0U ? "" : ",", record.*columns.at(column).second);
+			}
+			m_buffer.push_back('\n');
+		}
+	}
+	else
+	{
+		AppendLittleEndian(m_buffer, static_cast<uint32_t>(records.size()));
+		for (const auto& column : columns)
+		{
+			for (const auto& record : records)
+			{
+				AppendLittleEndian(m_buffer, record.*column.second);
+			}
+		}
+	}
+
+	m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+}
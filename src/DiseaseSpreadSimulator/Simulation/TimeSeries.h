@@ -0,0 +1,105 @@
+#pragma once
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace DiseaseSpreadSimulation
+{
+	// Counters of one community at the start of a day
+	struct DailyRecord
+	{
+		uint32_t run{0U};
+		uint32_t day{0U};
+		uint32_t communityID{0U};
+		uint32_t susceptible{0U};
+		uint32_t exposed{0U};
+		uint32_t infectious{0U};
+		uint32_t recovered{0U};
+		uint32_t dead{0U};
+		uint32_t traveling{0U};
+		// Currently inside quarantine
+		uint32_t quarantined{0U};
+		// Since the start of the run
+		uint32_t positiveTests{0U};
+		uint32_t personsQuarantined{0U};
+	};
+
+	// Appends daily records to a file. The records are written in batches by a background thread,
+	// so appending only hands them over.
+	// Csv has a header line and one line per record.
+	// Columnar starts with the magic, version and column names followed by blocks of a row count and every column after another.
+	// Every number of the columnar format is an unsigned 32 bit integer in little endian.
+	class TimeSeriesSink
+	{
+	public:
+		enum class Format
+		{
+			Csv,
+			Columnar
+		};
+
+		// Throws std::runtime_error when the file can't be opened
+		TimeSeriesSink(const std::string& filename, Format format);
+		TimeSeriesSink(const TimeSeriesSink&) = delete;
+		TimeSeriesSink(TimeSeriesSink&&) = delete;
+		TimeSeriesSink& operator=(const TimeSeriesSink&) = delete;
+		TimeSeriesSink& operator=(TimeSeriesSink&&) = delete;
+		// Writes the remaining records. Call Close first to learn whether that worked.
+		~TimeSeriesSink();
+
+		void Append(std::vector<DailyRecord> records);
+		// Block until every appended record is written to the file. Throws std::runtime_error when writing failed.
+		void Flush();
+		// Write the remaining records, stop the writer and close the file. Throws std::runtime_error when writing or closing failed.
+		// Nothing can be appended afterwards.
+		void Close();
+
+		// Csv for filenames ending with .csv and columnar for everything else
+		static Format FormatFromFilename(const std::string& filename);
+
+		// "DSTS" in little endian
+		static constexpr uint32_t magic{0x53545344U};
+		static constexpr uint32_t version{1U};
+		static constexpr std::array<std::pair<const char*, uint32_t DailyRecord::*>, 12> columns{{
+			{"run", &DailyRecord::run},
+			{"day", &DailyRecord::day},
+			{"community", &DailyRecord::communityID},
+			{"susceptible", &DailyRecord::susceptible},
+			{"exposed", &DailyRecord::exposed},
+			{"infectious", &DailyRecord::infectious},
+			{"recovered", &DailyRecord::recovered},
+			{"dead", &DailyRecord::dead},
+			{"traveling", &DailyRecord::traveling},
+			{"quarantined", &DailyRecord::quarantined},
+			{"positive_tests", &DailyRecord::positiveTests},
+			{"persons_quarantined", &DailyRecord::personsQuarantined}}};
+
+	private:
+		void WriterLoop();
+		void WriteHeader();
+		void WriteBatch(const std::vector<DailyRecord>& records);
+		void StopWriter();
+
+		std::ofstream m_file;
+		const Format m_format;
+		// Written by the writer thread only
+		std::string m_buffer{};
+
+		std::mutex m_mutex;
+		std::condition_variable m_hasWork;
+		std::condition_variable m_idle;
+		std::deque<std::vector<DailyRecord>> m_batches{};
+		bool m_writing{false};
+		bool m_failed{false};
+		bool m_stop{false};
+		// Started last, after everything it uses
+		std::thread m_writer;
+	};
+} // namespace DiseaseSpreadSimulation
@@ -0,0 +1,49 @@
+#include "Simulation/UpdateScheduler.h"
+#include <numeric>
+#include <utility>
+
+void DiseaseSpreadSimulation::UpdateScheduler::ScheduleEveryone()
+{
+	everyoneDue = true;
+}
+
+bool DiseaseSpreadSimulation::UpdateScheduler::IsEveryoneDue() const
+{
+	return everyoneDue;
+}
+
+void DiseaseSpreadSimulation::UpdateScheduler::Clear()
+{
+	for (auto& slot : wheel)
+	{
+		slot.clear();
+	}
+	everyoneDue = false;
+}
+
+void DiseaseSpreadSimulation::UpdateScheduler::Schedule(uint32_t personIndex, uint32_t hour)
+{
+	if (hour < hoursPerDay)
+	{
+		wheel[hour].push_back(personIndex);
+	}
+}
+
+const std::vector<uint32_t>& DiseaseSpreadSimulation::UpdateScheduler::TakeDue(uint32_t hour)
+{
+	due.clear();
+	if (hour < hoursPerDay)
+	{
+		// Swap to keep the capacity of both vectors
+		std::swap(due, wheel[hour]);
+	}
+	return due;
+}
+
+size_t DiseaseSpreadSimulation::UpdateScheduler::ScheduledCount() const
+{
+	return std::accumulate(wheel.begin(), wheel.end(), static_cast<size_t>(0), [](size_t count, const auto& slot)
+		{
+			return count + slot.size();
+		});
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <vector>
+
+namespace DiseaseSpreadSimulation
+{
+	// Timing wheel with one slot per hour of the day.
+	// Everybody is updated at the start of a day. During the day a person is only updated at the hours it was scheduled for.
+	class UpdateScheduler
+	{
+	public:
+		static constexpr uint32_t hoursPerDay{24U};
+
+		UpdateScheduler() = default;
+
+		// Update everybody at the next hour. Needed when the population has changed.
+		void ScheduleEveryone();
+		[[nodiscard]] bool IsEveryoneDue() const;
+		// Drop everything scheduled. Call when everybody was updated.
+		void Clear();
+		// Hours outside of the day are dropped. Everybody will be updated at the start of the next day anyway.
+		void Schedule(uint32_t personIndex, uint32_t hour);
+		// Returns the indices of everybody due at the hour. Valid until the next call.
+		// They have to be scheduled again after their update.
+		const std::vector<uint32_t>& TakeDue(uint32_t hour);
+
+		[[nodiscard]] size_t ScheduledCount() const;
+
+	private:
+		std::array<std::vector<uint32_t>, hoursPerDay> wheel{};
+		std::vector<uint32_t> due{};
+		bool everyoneDue{true};
+	};
+} // namespace DiseaseSpreadSimulation
@@ -35,6 +35,8 @@
 #include "Disease/Disease.h"
 #include "Disease/Infection.h"
 #include "Person/Person.h"
+#include "Person/PopulationStore.h"
 #include "Places/Places.h"
+#include "Places/PlaceTable.h"
 #include "Places/Community.h"
 #include "Simulation/MeasureTime.h"
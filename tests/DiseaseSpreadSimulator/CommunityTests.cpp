@@ -1,11 +1,24 @@
 #include <gtest/gtest.h>
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
 #include "Enums.h"
 #include "Places/Community.h"
 #include "Places/Places.h"
 #include "Person/Person.h"
 #include "Person/PersonBehavior.h"
+#include "Person/PopulationStore.h"
+#include "Simulation/UpdateScheduler.h"
+#include "Disease/DiseaseBuilder.h"
+#include "Simulation/Snapshot.h"
+#include "Simulation/PopulationCache.h"
+#include "Simulation/Simulation.h"
+#include "Simulation/ThreadPool.h"
 
 namespace UnitTests
 {
@@ -132,6 +145,247 @@ namespace UnitTests
 		ASSERT_TRUE(transferPerson4);
 		ASSERT_EQ(transferPerson4->GetID(), person4ID);
 	}
+	TEST_F(CommunityTest, PopulationStoreFollowsPopulation)
+	{
+		using namespace DiseaseSpreadSimulation;
+		DiseaseBuilder builder;
+		const auto disease = builder.CreateCorona();
+
+		community.AddPerson(Person{Age_Group::UnderThirty, Sex::Female, behavior, &community});
+		community.AddPerson(Person{Age_Group::UnderEighty, Sex::Male, behavior, &community});
+		community.AddPerson(Person{Age_Group::UnderTen, Sex::Male, behavior, &community});
+
+		const auto& store = community.GetPopulationStore();
+		ASSERT_EQ(store.Size(), 3);
+		EXPECT_EQ(store.Count().susceptible, 3);
+		EXPECT_EQ(community.CurrentInfectionMax(), 0);
+
+		community.GetPopulation().at(0).Contaminate(&disease);
+		EXPECT_EQ(store.Count().exposed, 1);
+		EXPECT_EQ(store.Count().withDisease, 1);
+
+		community.GetPopulation().at(1).Kill();
+		EXPECT_EQ(store.Count().dead, 1);
+
+		auto counts = store.Count();
+		EXPECT_EQ(counts.alive, 2);
+		EXPECT_EQ(counts.susceptible, 1);
+		EXPECT_EQ(counts.exposed, 1);
+		EXPECT_EQ(counts.withDisease, 1);
+		EXPECT_EQ(counts.dead, 1);
+		EXPECT_EQ(community.CurrentInfectionMax(), 2);
+
+		// A copy does not own the row of the original
+		auto copy = community.GetPopulation().at(2);
+		copy.Kill();
+		EXPECT_EQ(store.Count().alive, 2);
+		EXPECT_EQ(store.Count().dead, 1);
+
+		// Rows follow the population when a person leaves
+		community.RemovePerson(community.GetPopulation().at(0));
+		ASSERT_EQ(store.Size(), 2);
+		EXPECT_EQ(store.Count().withDisease, 0);
+		EXPECT_EQ(store.Count().alive, 1);
+		community.GetPopulation().at(1).Kill();
+		EXPECT_EQ(store.Count().alive, 0);
+		EXPECT_EQ(store.Count().dead, 2);
+	}
+	TEST_F(CommunityTest, AddedAndRemovedRowsKeepCounters)
+	{
+		using namespace DiseaseSpreadSimulation;
+		DiseaseBuilder builder;
+		const auto disease = builder.CreateCorona();
+
+		Person infected{Age_Group::UnderFifty, Sex::Male, behavior, &community};
+		infected.Contaminate(&disease);
+		Person dead{Age_Group::UnderEighty, Sex::Female, behavior, &community};
+		dead.Kill();
+		community.AddPerson(Person{Age_Group::UnderThirty, Sex::Female, behavior, &community});
+		community.AddPerson(infected);
+		community.AddPerson(dead);
+		std::vector<Person> morePersons{Person{Age_Group::UnderTen, Sex::Male, behavior, &community}, Person{Age_Group::UnderTwenty, Sex::Female, behavior, &community}};
+		community.AddPopulation(morePersons);
+
+		const auto expectRowsFollowPopulation = [this]()
+		{
+			const auto& store = community.GetPopulationStore();
+			const auto& population = community.GetPopulation();
+			ASSERT_EQ(store.Size(), population.size());
+			const auto counts = store.Count();
+			const auto recount = store.Recount();
+			EXPECT_EQ(counts.alive, recount.alive);
+			EXPECT_EQ(counts.susceptible, recount.susceptible);
+			EXPECT_EQ(counts.exposed, recount.exposed);
+			EXPECT_EQ(counts.withDisease, recount.withDisease);
+			EXPECT_EQ(counts.dead, recount.dead);
+			EXPECT_EQ(counts.everInfected, recount.everInfected);
+		};
+		expectRowsFollowPopulation();
+		EXPECT_EQ(community.GetPopulationStore().Count().exposed, 1U);
+		EXPECT_EQ(community.GetPopulationStore().Count().dead, 1U);
+
+		community.RemovePerson(infected);
+		expectRowsFollowPopulation();
+		EXPECT_EQ(community.GetPopulationStore().Count().exposed, 0U);
+
+		static_cast<void>(community.TransferPerson(dead));
+		expectRowsFollowPopulation();
+		EXPECT_EQ(community.GetPopulationStore().Count().dead, 0U);
+
+		// The persons after a removed one still write their own rows
+		community.GetPopulation().back().Contaminate(&disease);
+		expectRowsFollowPopulation();
+		EXPECT_EQ(community.GetPopulationStore().Count().exposed, 1U);
+	}
+	TEST(CommunityCopyTests, CopyPointsIntoItself)
+	{
+		using namespace DiseaseSpreadSimulation;
+		DiseaseBuilder builder;
+		const auto disease = builder.CreateCorona();
+
+		Community original{300U, Country::USA};
+		Community copy{original};
+		auto& population = copy.GetPopulation();
+		ASSERT_EQ(population.size(), original.GetPopulation().size());
+
+		const auto isInside = [](const auto* element, const auto& elements)
+		{
+			return !elements.empty() && element >= elements.data() && element < elements.data() + elements.size();
+		};
+		auto& places = copy.GetPlaces();
+		for (size_t i = 0; i < population.size(); i++)
+		{
+			auto& person = population[i];
+			auto& originalPerson = original.GetPopulation()[i];
+			EXPECT_EQ(person.GetID(), originalPerson.GetID());
+			EXPECT_EQ(person.GetCommunity(), &copy);
+			EXPECT_TRUE(isInside(person.GetHome(), places.homes));
+			EXPECT_EQ(person.GetHome() - places.homes.data(), originalPerson.GetHome() - original.GetPlaces().homes.data());
+			EXPECT_EQ(person.GetWhereabouts(), person.GetHome());
+			if (person.GetWorkplace() != nullptr)
+			{
+				EXPECT_TRUE(isInside(person.GetWorkplace(), places.workplaces));
+			}
+			if (person.GetSchool() != nullptr)
+			{
+				EXPECT_TRUE(isInside(person.GetSchool(), places.schools));
+			}
+		}
+		for (auto& home : places.homes)
+		{
+			for (auto* person : home.GetPeople())
+			{
+				EXPECT_TRUE(isInside(person, population));
+				EXPECT_EQ(person->GetHome(), &home);
+			}
+		}
+
+		// Changing the copy leaves the original alone
+		population.front().Contaminate(&disease);
+		population.back().Kill();
+		EXPECT_EQ(copy.CurrentInfectionMax(), 2U);
+		EXPECT_EQ(original.CurrentInfectionMax(), 0U);
+		EXPECT_TRUE(original.GetPopulation().front().IsSusceptible());
+
+		// Moving keeps the persons pointing at their community
+		Community moved{std::move(copy)};
+		EXPECT_EQ(moved.GetPopulation().front().GetCommunity(), &moved);
+	}
+	TEST(CommunityCopyTests, MoveAndAssignKeepTravelers)
+	{
+		using namespace DiseaseSpreadSimulation;
+		Community original{300U, Country::USA};
+		original.SetContainmentMeasures().SetMaskMandate(true);
+		// Run the days until the first person leaves on a trip
+		std::optional<size_t> travelerIndex{};
+		for (uint32_t hour = 0U; hour < 24U * 60U && !travelerIndex; hour++)
+		{
+			auto& population = original.GetPopulation();
+			for (size_t i = 0; i < population.size() && !travelerIndex; i++)
+			{
+				population[i].Update(hour % 24U, true, hour % 24U == 0U);
+				if (population[i].IsTraveling())
+				{
+					travelerIndex = i;
+				}
+			}
+		}
+		ASSERT_TRUE(travelerIndex.has_value());
+		const auto travelers = original.GetTravelLocation().GetPersonCount();
+		ASSERT_GT(travelers, 0U);
+
+		// Travelers point at the travel location of the community they were moved into
+		Community moved{std::move(original)};
+		auto& traveler = moved.GetPopulation()[*travelerIndex];
+		EXPECT_EQ(traveler.GetWhereabouts(), &moved.GetTravelLocation());
+		EXPECT_EQ(moved.GetTravelLocation().GetPersonCount(), travelers);
+		EXPECT_TRUE(moved.ContainmentMeasures().IsMaskMandate());
+
+		Community assigned{100U, Country::USA};
+		assigned = std::move(moved);
+		auto& assignedTraveler = assigned.GetPopulation()[*travelerIndex];
+		EXPECT_EQ(assignedTraveler.GetWhereabouts(), &assigned.GetTravelLocation());
+		EXPECT_TRUE(assigned.ContainmentMeasures().IsMaskMandate());
+
+		// A copy assigned through a temporary points into itself as well
+		Community copied{100U, Country::USA};
+		copied = assigned;
+		auto& copiedTraveler = copied.GetPopulation()[*travelerIndex];
+		EXPECT_EQ(copiedTraveler.GetWhereabouts(), &copied.GetTravelLocation());
+		EXPECT_TRUE(copied.ContainmentMeasures().IsMaskMandate());
+		copied.TransferToHome(&copiedTraveler);
+		EXPECT_EQ(copied.GetTravelLocation().GetPersonCount(), travelers - 1U);
+		EXPECT_EQ(assigned.GetTravelLocation().GetPersonCount(), travelers);
+
+		assigned.TransferToHome(&assignedTraveler);
+		EXPECT_EQ(assigned.GetTravelLocation().GetPersonCount(), travelers - 1U);
+	}
+	TEST_F(CommunityTest, PopulationCountersMatchRecount)
+	{
+		using namespace DiseaseSpreadSimulation;
+		DiseaseBuilder builder;
+		const auto disease = builder.CreateCorona();
+
+		constexpr size_t populationSize{400U};
+		for (size_t i = 0; i < populationSize; i++)
+		{
+			community.AddPerson(Person{Age_Group::UnderThirty, Sex::Female, behavior, &community});
+		}
+
+		// Persons write their rows from different threads at the same time
+		ThreadPool pool{4U};
+		auto& population = community.GetPopulation();
+		for (size_t i = 0; i < populationSize; i++)
+		{
+			pool.Submit([&population, &disease, i]()
+				{
+					if (i % 3U == 0U)
+					{
+						population[i].Contaminate(&disease);
+					}
+					if (i % 5U == 0U)
+					{
+						population[i].Kill();
+					}
+				});
+		}
+		pool.Wait();
+
+		const auto& store = community.GetPopulationStore();
+		const auto counts = store.Count();
+		const auto recount = store.Recount();
+		EXPECT_EQ(counts.alive, recount.alive);
+		EXPECT_EQ(counts.susceptible, recount.susceptible);
+		EXPECT_EQ(counts.exposed, recount.exposed);
+		EXPECT_EQ(counts.withDisease, recount.withDisease);
+		EXPECT_EQ(counts.dead, recount.dead);
+		EXPECT_EQ(counts.everInfected, recount.everInfected);
+		EXPECT_EQ(counts.dead, populationSize / 5U);
+
+		// A copied store keeps the counts
+		const PopulationStore copy{store};
+		EXPECT_EQ(copy.Count().everInfected, counts.everInfected);
+	}
 	TEST_F(CommunityTest, TransferToPlace)
 	{
 		using namespace DiseaseSpreadSimulation;
@@ -170,6 +424,76 @@ namespace UnitTests
 		auto* travel = community.TransferToTravelLocation(&person);
 		EXPECT_EQ(travel->GetType(), Place_Type::Travel);
 	}
+	TEST_F(CommunityTest, DeferredTransfers)
+	{
+		using namespace DiseaseSpreadSimulation;
+		community.AddPlace(Home{});
+		community.AddPlace(Workplace{});
+		auto& home = community.GetHomes().back();
+		auto& work = community.GetPlaces().workplaces.back();
+
+		community.AddPerson(Person{Age_Group::UnderThirty, Sex::Female, behavior, &community});
+		auto& person = community.GetPopulation().back();
+		person.SetHome(&home);
+		person.SetWorkplace(&work);
+		ASSERT_EQ(home.GetPersonCount(), 1);
+
+		community.DeferTransfers(true);
+		// Rule out travel for today and go to work
+		person.Update(1U, true, false);
+		person.Update(8U, true, false);
+		ASSERT_EQ(person.GetWhereabouts()->GetType(), Place_Type::Workplace);
+		EXPECT_EQ(home.GetPersonCount(), 1);
+		EXPECT_EQ(work.GetPersonCount(), 0);
+
+		community.DeferTransfers(false);
+		community.ApplyTransfers();
+		EXPECT_EQ(home.GetPersonCount(), 0);
+		ASSERT_EQ(work.GetPersonCount(), 1);
+		EXPECT_EQ(work.GetPeople().front()->GetID(), person.GetID());
+	}
+	TEST(CommunityPlaceTableTests, PlaceTableFollowsPlaces)
+	{
+		using namespace DiseaseSpreadSimulation;
+		Community community{200U, Country::USA};
+		const auto expectTableFollowsPlaces = [](Community& indexed)
+		{
+			indexed.IndexPlaces();
+			const auto& table = indexed.GetPlaceTable();
+			auto& population = indexed.GetPopulation();
+			ASSERT_EQ(table.Size(), indexed.GetPlaces().Count());
+			indexed.GetPlaces().ForEachPlace(0U, table.Size(), [&table, &population](Place& place, size_t index)
+				{
+					const auto row = static_cast<uint32_t>(index);
+					EXPECT_EQ(table.GetRow(row).type, place.GetType());
+					const auto occupants = table.GetOccupants(row);
+					ASSERT_EQ(occupants.size(), place.GetPersonCount());
+					for (size_t i = 0; i < occupants.size(); i++)
+					{
+						EXPECT_EQ(&population.at(occupants[i]), place.GetPeople().at(i));
+					}
+				});
+		};
+		expectTableFollowsPlaces(community);
+
+		// A home that outgrows its range gets a new layout
+		auto& home = community.GetHomes().front();
+		const auto capacity = community.GetPlaceTable().GetRow(0U).capacity;
+		for (auto& person : community.GetPopulation())
+		{
+			if (person.GetHome() != &home)
+			{
+				home.AddPerson(&person);
+			}
+		}
+		ASSERT_GT(home.GetPersonCount(), capacity);
+		expectTableFollowsPlaces(community);
+
+		// Copies keep the layout and point into their own population
+		auto copy = community;
+		EXPECT_EQ(copy.GetPlaceTable().GetRow(0U).capacity, community.GetPlaceTable().GetRow(0U).capacity);
+		expectTableFollowsPlaces(copy);
+	}
 	TEST_F(CommunityTest, AddHome)
 	{
 		ASSERT_TRUE(community.GetHomes().empty());
@@ -212,4 +536,166 @@ namespace UnitTests
 		community.AddPlace(DiseaseSpreadSimulation::Morgue{});
 		ASSERT_FALSE(community.GetPlaces().morgues.empty());
 	}
+	TEST_F(CommunityTest, UpdateSchedulerHandsOutDuePersons)
+	{
+		auto& scheduler = community.GetUpdateScheduler();
+		ASSERT_TRUE(scheduler.IsEveryoneDue());
+
+		scheduler.Clear();
+		EXPECT_FALSE(scheduler.IsEveryoneDue());
+
+		scheduler.Schedule(0U, 8U);
+		scheduler.Schedule(1U, 8U);
+		scheduler.Schedule(2U, 17U);
+		// Outside of the day, will be updated at the start of the next day
+		scheduler.Schedule(3U, 24U);
+		EXPECT_EQ(scheduler.ScheduledCount(), 3U);
+
+		EXPECT_TRUE(scheduler.TakeDue(7U).empty());
+		const auto& due = scheduler.TakeDue(8U);
+		ASSERT_EQ(due.size(), 2U);
+		EXPECT_EQ(due.at(0), 0U);
+		EXPECT_EQ(due.at(1), 1U);
+		EXPECT_EQ(scheduler.ScheduledCount(), 1U);
+
+		// A change of the population makes everybody due again
+		community.AddPerson({DiseaseSpreadSimulation::Age_Group::UnderThirty, DiseaseSpreadSimulation::Sex::Female, behavior, &community});
+		EXPECT_TRUE(scheduler.IsEveryoneDue());
+	}
+	TEST_F(CommunityTest, SnapshotRoundTrip)
+	{
+		DiseaseSpreadSimulation::DiseaseBuilder builder;
+		const std::vector<DiseaseSpreadSimulation::Disease> diseases{builder.CreateCorona()};
+
+		DiseaseSpreadSimulation::Community original{200U, DiseaseSpreadSimulation::Country::USA};
+		original.SetContainmentMeasures().SetMaskMandate();
+		auto& population = original.GetPopulation();
+		population.front().Contaminate(&diseases.front());
+		for (auto hour = 0U; hour < 12U; hour++)
+		{
+			for (auto& person : population)
+			{
+				person.Update(hour, true, hour == 0U);
+			}
+		}
+
+		std::stringstream stream;
+		DiseaseSpreadSimulation::BinaryWriter writer(stream);
+		original.Save(writer, diseases);
+
+		DiseaseSpreadSimulation::BinaryReader reader(stream);
+		community.Load(reader, diseases);
+
+		EXPECT_EQ(community.GetID(), original.GetID());
+		EXPECT_TRUE(community.ContainmentMeasures().IsMaskMandate());
+		EXPECT_EQ(community.GetPlaces().homes.size(), original.GetPlaces().homes.size());
+		EXPECT_EQ(community.GetPlaces().workplaces.size(), original.GetPlaces().workplaces.size());
+
+		auto& restored = community.GetPopulation();
+		ASSERT_EQ(restored.size(), population.size());
+		for (size_t i = 0; i < population.size(); i++)
+		{
+			EXPECT_EQ(restored[i].GetID(), population[i].GetID());
+			EXPECT_EQ(restored[i].GetAgeGroup(), population[i].GetAgeGroup());
+			EXPECT_EQ(restored[i].GetDisease(), population[i].GetDisease());
+			EXPECT_EQ(restored[i].GetRandomStream(), population[i].GetRandomStream());
+			// The places are the same, but belong to the restored community
+			ASSERT_NE(restored[i].GetWhereabouts(), nullptr);
+			EXPECT_EQ(restored[i].GetWhereabouts()->GetID(), population[i].GetWhereabouts()->GetID());
+			EXPECT_EQ(restored[i].GetWhereabouts()->GetType(), population[i].GetWhereabouts()->GetType());
+			EXPECT_EQ(restored[i].GetHome()->GetID(), population[i].GetHome()->GetID());
+			EXPECT_EQ(restored[i].GetCommunity(), &community);
+		}
+		for (size_t i = 0; i < original.GetPlaces().homes.size(); i++)
+		{
+			EXPECT_EQ(community.GetPlaces().homes[i].GetPersonCount(), original.GetPlaces().homes[i].GetPersonCount());
+		}
+		EXPECT_EQ(community.GetPopulationStore().Count().withDisease, original.GetPopulationStore().Count().withDisease);
+
+		// A snapshot that ends early is rejected
+		std::stringstream truncated(stream.str().substr(0, 100));
+		DiseaseSpreadSimulation::BinaryReader truncatedReader(truncated);
+		DiseaseSpreadSimulation::Community other{0U, DiseaseSpreadSimulation::Country::USA};
+		EXPECT_THROW(other.Load(truncatedReader, diseases), std::runtime_error);
+	}
+	TEST_F(CommunityTest, PopulationCacheRoundTrip)
+	{
+		constexpr uint64_t populationSize{300U};
+		constexpr uint64_t seed{3U};
+		const auto directory = std::filesystem::temp_directory_path() / "populationCacheTest";
+		std::filesystem::remove_all(directory);
+		const DiseaseSpreadSimulation::PopulationCache cache{directory};
+		EXPECT_FALSE(cache.Find(populationSize, DiseaseSpreadSimulation::Country::USA, seed).has_value());
+
+		DiseaseSpreadSimulation::Community original{populationSize, DiseaseSpreadSimulation::Country::USA};
+		cache.Store(original.CachePopulation(), populationSize, DiseaseSpreadSimulation::Country::USA, seed);
+		EXPECT_FALSE(cache.Find(populationSize, DiseaseSpreadSimulation::Country::USA, seed + 1U).has_value());
+		const auto cached = cache.Find(populationSize, DiseaseSpreadSimulation::Country::USA, seed);
+		ASSERT_TRUE(cached.has_value());
+
+		DiseaseSpreadSimulation::Community loaded{*cached, DiseaseSpreadSimulation::Country::USA};
+		auto& population = original.GetPopulation();
+		auto& restored = loaded.GetPopulation();
+		ASSERT_EQ(restored.size(), population.size());
+		const auto& places = original.GetPlaces();
+		const auto& loadedPlaces = loaded.GetPlaces();
+		for (size_t i = 0; i < population.size(); i++)
+		{
+			EXPECT_EQ(restored[i].GetID(), population[i].GetID());
+			EXPECT_EQ(restored[i].GetAgeGroup(), population[i].GetAgeGroup());
+			EXPECT_EQ(restored[i].GetSex(), population[i].GetSex());
+			EXPECT_EQ(restored[i].GetBehavior().travelNeed, population[i].GetBehavior().travelNeed);
+			EXPECT_EQ(restored[i].GetRandomStream(), population[i].GetRandomStream());
+			EXPECT_EQ(restored[i].GetHome() - loadedPlaces.homes.data(), population[i].GetHome() - places.homes.data());
+			EXPECT_EQ(restored[i].GetWhereabouts(), restored[i].GetHome());
+			EXPECT_EQ(restored[i].GetWorkplace() == nullptr, population[i].GetWorkplace() == nullptr);
+			EXPECT_EQ(restored[i].GetCommunity(), &loaded);
+		}
+		for (size_t i = 0; i < places.homes.size(); i++)
+		{
+			EXPECT_EQ(loadedPlaces.homes[i].GetPersonCount(), places.homes[i].GetPersonCount());
+		}
+
+		// A person with a flag that is neither true nor false is rejected
+		const auto filename = cache.Filename(populationSize, DiseaseSpreadSimulation::Country::USA, seed);
+		{
+			std::fstream file{filename, std::ios::binary | std::ios::in | std::ios::out};
+			file.seekp(static_cast<std::streamoff>(std::filesystem::file_size(filename) - sizeof(DiseaseSpreadSimulation::CachedPerson) + offsetof(DiseaseSpreadSimulation::CachedPerson, canWorkFromHome)));
+			file.put('\x05');
+		}
+		EXPECT_THROW(static_cast<void>(cache.Find(populationSize, DiseaseSpreadSimulation::Country::USA, seed)), std::runtime_error);
+
+		// A file that ends early is rejected
+		std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 1U);
+		EXPECT_THROW(static_cast<void>(cache.Find(populationSize, DiseaseSpreadSimulation::Country::USA, seed)), std::runtime_error);
+		std::filesystem::remove_all(directory);
+	}
+	TEST_F(CommunityTest, CachedPopulationRunsLikeCreated)
+	{
+		constexpr uint64_t populationSize{500U};
+		constexpr uint64_t seed{9U};
+		constexpr uint32_t days{10U};
+		const std::string diseaseFilename{};
+		const auto directory = std::filesystem::temp_directory_path() / "populationCacheRunTest";
+		std::filesystem::remove_all(directory);
+		const DiseaseSpreadSimulation::PopulationCache cache{directory};
+
+		// The first run creates the population and the second loads it
+		const auto run = [&]()
+		{
+			DiseaseSpreadSimulation::Simulation simulation{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+			simulation.SetPopulationCache(&cache);
+			return simulation.RunScenario(days, DiseaseSpreadSimulation::DiseaseContainmentMeasures::Nothing);
+		};
+		const auto created = run();
+		ASSERT_TRUE(std::filesystem::exists(cache.Filename(populationSize, DiseaseSpreadSimulation::Country::USA, seed)));
+		const auto loaded = run();
+
+		EXPECT_EQ(loaded.counts.everInfected, created.counts.everInfected);
+		EXPECT_EQ(loaded.counts.withDisease, created.counts.withDisease);
+		EXPECT_EQ(loaded.counts.infectious, created.counts.infectious);
+		EXPECT_EQ(loaded.counts.recovered, created.counts.recovered);
+		EXPECT_EQ(loaded.positiveTests, created.positiveTests);
+		std::filesystem::remove_all(directory);
+	}
 } // namespace UnitTests
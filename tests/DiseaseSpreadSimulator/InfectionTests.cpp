@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <numeric>
 #include <string>
 #include <vector>
 #include <utility>
@@ -10,6 +11,8 @@
 #include "Person/PersonBehavior.h"
 #include "Disease/Disease.h"
 #include "Disease/Infection.h"
+#include "Simulation/Simulation.h"
+#include "RandomNumbers.h"
 
 namespace UnitTests
 {
@@ -200,4 +203,113 @@ namespace UnitTests
 		// Less than 20% should be infected
 		EXPECT_LT(willInfect, sampleSize * 0.2F);
 	}
+	TEST_F(InfectionTest, BatchDrawsLikeSingleContacts)
+	{
+		DiseaseSpreadSimulation::Community community(0U, DiseaseSpreadSimulation::Country::USA);
+		DiseaseSpreadSimulation::Infection infection;
+		infection.Contaminate(&disease, ageGroups.at(2));
+
+		// More people than fit into any vector and a chance near one half
+		static constexpr size_t batchSize{37U};
+		static constexpr float acceptanceFactor{0.5F};
+		const auto susceptibility = DiseaseSpreadSimulation::Infection::Susceptibility(acceptanceFactor, &community);
+		const std::vector<double> susceptibilities(batchSize, susceptibility);
+		std::vector<uint64_t> streamStates{};
+		for (size_t i = 0; i < batchSize; i++)
+		{
+			streamStates.push_back(Random::StreamSeed(3U, i));
+		}
+		auto batchStates = streamStates;
+		std::vector<uint8_t> infected(batchSize);
+		DiseaseSpreadSimulation::Infection::WillInfect(static_cast<double>(infection.GetSpreadFactor()), susceptibilities, batchStates, infected);
+
+		size_t infectedCount{0U};
+		for (size_t i = 0; i < batchSize; i++)
+		{
+			Random::Engine stream{streamStates.at(i)};
+			Random::StreamGuard streamGuard(stream);
+			EXPECT_EQ(infected.at(i) != 0U, DiseaseSpreadSimulation::Infection::WillInfect(infection, acceptanceFactor, &community));
+			EXPECT_EQ(batchStates.at(i), stream.GetState());
+			infectedCount += infected.at(i);
+		}
+		EXPECT_GT(infectedCount, 0U);
+		EXPECT_LT(infectedCount, batchSize);
+	}
+	TEST_F(InfectionTest, PairwiseBatchesLikeSingleContacts)
+	{
+		DiseaseSpreadSimulation::Community community(0U, DiseaseSpreadSimulation::Country::USA);
+		community.AddPlace(DiseaseSpreadSimulation::Home{});
+		auto* place = &community.GetHomes().back();
+		static constexpr size_t placeSize{60U};
+		const DiseaseSpreadSimulation::PersonBehavior cautious{100U, 100U, 1.F, 0.F};
+		std::vector<DiseaseSpreadSimulation::Person> population{};
+		population.reserve(placeSize);
+		for (size_t i = 0; i < placeSize; i++)
+		{
+			auto& person = population.emplace_back(DiseaseSpreadSimulation::Age_Group::UnderThirty, DiseaseSpreadSimulation::Sex::Female, cautious, &community, place);
+			if (i % 6U == 0U)
+			{
+				person.Contaminate(&disease);
+				while (!person.IsInfectious())
+				{
+					person.Update(1U, false, true);
+				}
+			}
+		}
+		std::vector<Random::Engine> streams{};
+		for (auto& person : population)
+		{
+			streams.push_back(person.GetRandomStream());
+		}
+
+		std::vector<uint32_t> occupants(placeSize);
+		std::iota(occupants.begin(), occupants.end(), 0U);
+		std::vector<DiseaseSpreadSimulation::Simulation::InfectionEvent> events{};
+		DiseaseSpreadSimulation::Simulation::CollectInfections(population, occupants, DiseaseSpreadSimulation::Contact_Model::Pairwise, events);
+		ASSERT_FALSE(events.empty());
+
+		// Every susceptible person meets the infectious people one by one until the first infects it
+		std::vector<Random::Engine> batchStreams{};
+		for (size_t i = 0; i < placeSize; i++)
+		{
+			batchStreams.push_back(population.at(i).GetRandomStream());
+			population.at(i).GetRandomStream() = streams.at(i);
+		}
+		size_t event{0U};
+		for (auto& susceptible : population)
+		{
+			if (!susceptible.IsSusceptible())
+			{
+				continue;
+			}
+			for (auto& infectious : population)
+			{
+				if (infectious.IsInfectious() && susceptible.WillBeInfectedBy(infectious))
+				{
+					ASSERT_LT(event, events.size());
+					EXPECT_EQ(events.at(event).infected, &susceptible);
+					EXPECT_EQ(events.at(event).spreader, &infectious);
+					event++;
+					break;
+				}
+			}
+		}
+		EXPECT_EQ(event, events.size());
+		for (size_t i = 0; i < placeSize; i++)
+		{
+			EXPECT_EQ(population.at(i).GetRandomStream(), batchStreams.at(i));
+		}
+	}
+	TEST_F(InfectionTest, Susceptibility)
+	{
+		DiseaseSpreadSimulation::Community community(0U, DiseaseSpreadSimulation::Country::USA);
+
+		// From a full chance without any acceptance to a tenth with full acceptance
+		EXPECT_DOUBLE_EQ(DiseaseSpreadSimulation::Infection::Susceptibility(0.F, &community), 1.);
+		EXPECT_NEAR(DiseaseSpreadSimulation::Infection::Susceptibility(1.F, &community), 0.1, 1e-6); // NOLINT(*-magic-numbers)
+
+		// Masks lower the chance
+		community.SetContainmentMeasures().SetMaskMandate(true);
+		EXPECT_LT(DiseaseSpreadSimulation::Infection::Susceptibility(0.F, &community), 0.5); // NOLINT(*-magic-numbers)
+	}
 } // namespace UnitTests
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Simulation/Mobility.h"
+#include "Simulation/ProcessGroup.h"
+#include "Simulation/Simulation.h"
+#include "Simulation/ThreadPool.h"
+#include "Simulation/TimeSeries.h"
+
+namespace UnitTests
+{
+	class MobilityTests : public ::testing::Test
+	{
+	protected:
+		std::string mobilityFilename{(std::filesystem::temp_directory_path() / "mobilityTest.csv").string()};
+		std::string timeSeriesFilename{(std::filesystem::temp_directory_path() / "regionTest.csv").string()};
+
+		void TearDown() override
+		{
+			std::filesystem::remove(mobilityFilename);
+			std::filesystem::remove(timeSeriesFilename);
+		}
+
+		// The time series of a linked run on the given number of threads. Every day has one row for every community in order.
+		// Several processes are run as threads of this process connected by sockets.
+		std::vector<std::vector<uint32_t>> RunRegion(size_t threadCount, uint32_t processCount = 1U) const
+		{
+			constexpr uint32_t days{40U};
+			constexpr uint64_t populationSize{300U};
+			const std::string diseaseFilename{};
+			const auto mobility = DiseaseSpreadSimulation::MobilityMatrix::Ring(4U);
+			{
+				DiseaseSpreadSimulation::TimeSeriesSink sink{timeSeriesFilename, DiseaseSpreadSimulation::TimeSeriesSink::Format::Csv};
+				const auto run = [&](DiseaseSpreadSimulation::ProcessGroup* processGroup)
+				{
+					DiseaseSpreadSimulation::ThreadPool pool{threadCount};
+					DiseaseSpreadSimulation::Simulation simulation{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, 11U};
+					simulation.SetTimeSeriesSink(&sink);
+					simulation.SetMobility(&mobility, &pool, processGroup);
+					simulation.RunRegion(days);
+				};
+				if (processCount == 1U)
+				{
+					run(nullptr);
+				}
+				else
+				{
+					auto processGroups = DiseaseSpreadSimulation::ProcessGroup::Connect(processCount);
+					std::vector<std::exception_ptr> errors(processCount);
+					std::vector<std::thread> ranks{};
+					for (uint32_t rank = 0U; rank < processCount; rank++)
+					{
+						ranks.emplace_back([&run, &processGroups, &errors, rank]()
+							{
+								try
+								{
+									run(&processGroups[rank]);
+								}
+								catch (...)
+								{
+									errors[rank] = std::current_exception();
+								}
+							});
+					}
+					for (auto& rank : ranks)
+					{
+						rank.join();
+					}
+					for (const auto& error : errors)
+					{
+						if (error)
+						{
+							std::rethrow_exception(error);
+						}
+					}
+				}
+				sink.Flush();
+			}
+
+			// Rows without the run and the community id, which differ between the simulations
+			std::ifstream file{timeSeriesFilename};
+			std::vector<std::vector<uint32_t>> rows{};
+			std::string line{};
+			std::getline(file, line);
+			while (std::getline(file, line))
+			{
+				std::replace(line.begin(), line.end(), ',', ' ');
+				std::istringstream values{line};
+				std::vector<uint32_t> row{};
+				for (uint32_t value{}; values >> value;)
+				{
+					row.push_back(value);
+				}
+				row.erase(row.begin(), row.begin() + 3);
+				rows.push_back(row);
+			}
+			return rows;
+		}
+	};
+
+	TEST_F(MobilityTests, RingLinksNeighbors)
+	{
+		const auto ring = DiseaseSpreadSimulation::MobilityMatrix::Ring(4U);
+		ASSERT_EQ(ring.CommunityCount(), 4U);
+		const auto& links = ring.Links(0U);
+		ASSERT_EQ(links.size(), 2U);
+		EXPECT_EQ(links[0].destination, 1U);
+		EXPECT_EQ(links[1].destination, 3U);
+
+		EXPECT_EQ(DiseaseSpreadSimulation::MobilityMatrix::Ring(2U).Links(1U).size(), 1U);
+		// A single community keeps its travelers
+		const auto single = DiseaseSpreadSimulation::MobilityMatrix::Ring(1U);
+		Random::Engine engine{3U};
+		EXPECT_TRUE(single.Links(0U).empty());
+		EXPECT_EQ(single.PickDestination(0U, engine), 0U);
+	}
+	TEST_F(MobilityTests, PicksByWeight)
+	{
+		DiseaseSpreadSimulation::MobilityMatrix mobility{3U};
+		mobility.AddLink(0U, 1U, 1.F);
+		mobility.AddLink(0U, 2U, 3.F);
+		EXPECT_THROW(mobility.AddLink(0U, 3U, 1.F), std::out_of_range);
+		EXPECT_THROW(mobility.AddLink(0U, 1U, 0.F), std::invalid_argument);
+
+		constexpr int draws{40000};
+		Random::Engine engine{5U};
+		std::array<int, 3> picks{};
+		for (auto i = 0; i < draws; i++)
+		{
+			picks.at(mobility.PickDestination(0U, engine))++;
+		}
+		EXPECT_EQ(picks[0], 0);
+		EXPECT_NEAR(static_cast<double>(picks[2]) / draws, 0.75, 0.01);
+	}
+	TEST_F(MobilityTests, ReadsLinksFromFile)
+	{
+		{
+			std::ofstream file{mobilityFilename};
+			file << "# source,destination,weight\n0,1,2.5\n\n1,0,1\n";
+		}
+		const auto mobility = DiseaseSpreadSimulation::MobilityMatrix::FromFile(mobilityFilename, 2U);
+		ASSERT_EQ(mobility.Links(0U).size(), 1U);
+		EXPECT_FLOAT_EQ(mobility.Links(0U).front().weight, 2.5F);
+		EXPECT_EQ(mobility.Links(1U).front().destination, 0U);
+
+		{
+			std::ofstream file{mobilityFilename};
+			file << "0,5,1\n";
+		}
+		EXPECT_THROW(static_cast<void>(DiseaseSpreadSimulation::MobilityMatrix::FromFile(mobilityFilename, 2U)), std::runtime_error);
+	}
+	TEST_F(MobilityTests, ExchangeOrdersArrivalsBySource)
+	{
+		const auto ring = DiseaseSpreadSimulation::MobilityMatrix::Ring(4U);
+		DiseaseSpreadSimulation::TravelExchange exchange{ring};
+		const auto visitor = [](uint32_t source, uint32_t destination, uint32_t index)
+		{
+			DiseaseSpreadSimulation::Visitor created{};
+			created.source = source;
+			created.destination = destination;
+			created.index = index;
+			return created;
+		};
+
+		exchange.Send(visitor(2U, 1U, 7U));
+		exchange.Send(visitor(1U, 1U, 8U));
+		exchange.Send(visitor(0U, 1U, 9U));
+		// Travelers can stay inside their community but only go to linked ones
+		EXPECT_THROW(exchange.Send(visitor(0U, 2U, 1U)), std::out_of_range);
+		const auto arrivals = exchange.Arrivals(1U);
+		ASSERT_EQ(arrivals.size(), 3U);
+		EXPECT_EQ(arrivals[0].index, 9U);
+		EXPECT_EQ(arrivals[1].index, 8U);
+		EXPECT_EQ(arrivals[2].index, 7U);
+		EXPECT_TRUE(exchange.Arrivals(3U).empty());
+
+		exchange.Clear(2U);
+		EXPECT_EQ(exchange.Arrivals(1U).size(), 2U);
+	}
+	TEST_F(MobilityTests, RegionDoesNotDependOnThreadCount)
+	{
+		const auto rows = RunRegion(1U);
+		EXPECT_EQ(RunRegion(3U), rows);
+
+		constexpr size_t communityCount{4U};
+		ASSERT_EQ(rows.size(), 40U * communityCount);
+		// Only one community started with an infection, so the travelers have carried it into another
+		std::vector<bool> infected(communityCount, false);
+		for (size_t i = 0; i < rows.size(); i++)
+		{
+			// Exposed, infectious or recovered
+			if (rows[i][1] + rows[i][2] + rows[i][3] > 0U)
+			{
+				infected[i % communityCount] = true;
+			}
+		}
+		const auto infectedCommunities = std::count(infected.begin(), infected.end(), true);
+		EXPECT_GT(infectedCommunities, 1);
+	}
+#ifndef _WIN32
+	TEST_F(MobilityTests, RegionDoesNotDependOnProcessCount)
+	{
+		const auto rows = RunRegion(1U);
+		EXPECT_EQ(RunRegion(1U, 2U), rows);
+		EXPECT_EQ(RunRegion(2U, 4U), rows);
+	}
+#endif
+} // namespace UnitTests
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Simulation/OutputStage.h"
+
+namespace UnitTests
+{
+	TEST(OutputStageTests, RunsJobsInOrder)
+	{
+		std::vector<int> done{};
+		const auto caller = std::this_thread::get_id();
+		bool onCaller{false};
+		{
+			DiseaseSpreadSimulation::OutputStage stage{};
+			for (auto i = 0; i < 100; i++)
+			{
+				stage.Submit([&done, &onCaller, caller, i]()
+					{
+						onCaller = onCaller || std::this_thread::get_id() == caller;
+						done.push_back(i);
+					});
+			}
+			stage.Flush();
+			EXPECT_EQ(done.size(), 100U);
+
+			// The remaining jobs run before the stage is gone
+			stage.Submit([&done]()
+				{
+					done.push_back(100);
+				});
+		}
+
+		ASSERT_EQ(done.size(), 101U);
+		for (auto i = 0; i < 101; i++)
+		{
+			EXPECT_EQ(done[static_cast<size_t>(i)], i);
+		}
+		EXPECT_FALSE(onCaller);
+	}
+	TEST(OutputStageTests, FlushRethrows)
+	{
+		DiseaseSpreadSimulation::OutputStage stage{};
+		bool ranAfter{false};
+		stage.Submit([]()
+			{
+				throw std::runtime_error("Can't print");
+			});
+		stage.Submit([&ranAfter]()
+			{
+				ranAfter = true;
+			});
+		EXPECT_THROW(stage.Flush(), std::runtime_error);
+		EXPECT_TRUE(ranAfter);
+		EXPECT_NO_THROW(stage.Flush());
+	}
+} // namespace UnitTests
@@ -15,6 +15,8 @@
 #include "Person/Person.h"
 #include "Person/PersonBehavior.h"
 #include "Person/PersonPopulator.h"
+#include "Simulation/ThreadPool.h"
+#include "RandomNumbers.h"
 
 namespace UnitTests
 {
@@ -335,6 +337,29 @@ namespace UnitTests
 		} while (!patient3.HasDisease());
 		EXPECT_EQ(patient1.GetDiseaseName(), patient3.GetDiseaseName());
 	}
+	TEST_F(PersonTest, WillBeInfectedByChangesNothing)
+	{
+		InitCommunity();
+
+		DiseaseSpreadSimulation::Person patient1(DiseaseSpreadSimulation::Age_Group::UnderTwenty, DiseaseSpreadSimulation::Sex::Male, behavior, &community, &homes.back());
+		DiseaseSpreadSimulation::Person patient2(DiseaseSpreadSimulation::Age_Group::UnderTwenty, DiseaseSpreadSimulation::Sex::Male, behavior, &community, &homes.back());
+		patient1.Contaminate(&disease);
+		patient1.Update(0, true, true);
+		ASSERT_TRUE(patient1.IsInfectious());
+
+		// Only the decision is made, the infection is applied separately
+		bool willBeInfected{false};
+		do
+		{
+			willBeInfected = patient2.WillBeInfectedBy(patient1);
+			EXPECT_FALSE(patient2.HasDisease());
+		} while (!willBeInfected);
+		EXPECT_EQ(patient1.GetSpreadCount(), 0);
+
+		DiseaseSpreadSimulation::Person::SpreadDisease(patient1, patient2);
+		EXPECT_TRUE(patient2.HasDisease());
+		EXPECT_EQ(patient1.GetSpreadCount(), 1);
+	}
 	TEST_F(PersonTest, ContaminateAPerson)
 	{
 		InitCommunity();
@@ -735,6 +760,34 @@ namespace UnitTests
 			EXPECT_NEAR(homePercent2.at(i), distributionArray.at(i), 0.13F);
 		}
 	}
+	TEST_F(PersonPopulatorTest, SameSeedSamePopulation)
+	{
+		using namespace DiseaseSpreadSimulation;
+		// Large enough for several chunks that are created in parallel
+		constexpr size_t populationSize{3U * PersonPopulator::chunkSize + 10U};
+		constexpr uint64_t seed{42U};
+
+		// The age, home and workplace of every person as indices into the places
+		const auto createPopulation = [this]()
+		{
+			Random::SetSeed(seed);
+			PersonPopulator populationFactory(populationSize, PersonPopulator::GetCountryDistribution(country));
+			auto places = PlaceBuilder::CreatePlaces(populationSize, country);
+			auto population = populationFactory.CreatePopulation(country, places.homes, places.workplaces, places.schools, &community);
+
+			std::vector<std::array<int64_t, 3>> people{};
+			for (auto& person : population)
+			{
+				const auto workplaceIndex = person.GetWorkplace() == nullptr ? -1 : person.GetWorkplace() - places.workplaces.data();
+				people.push_back({static_cast<int64_t>(person.GetAgeGroup()), person.GetHome() - places.homes.data(), workplaceIndex});
+			}
+			return people;
+		};
+
+		const auto first = createPopulation();
+		ASSERT_EQ(first.size(), populationSize);
+		EXPECT_EQ(createPopulation(), first);
+	}
 	// Helper to sum up all working people
 	size_t SumWorkingPeople(size_t populationSize, const DiseaseSpreadSimulation::Country& country)
 	{
@@ -771,4 +824,37 @@ namespace UnitTests
 		EXPECT_EQ(PersonPopulator::WorkingPeopleCount(populationSize, country), SumWorkingPeople(populationSize, country));
 	}
 	// NOLINTEND(*-magic-numbers)
+	TEST_F(PersonPopulatorTest, SameForEveryThreadCount)
+	{
+		using namespace DiseaseSpreadSimulation;
+		// Several chunks and a last one that isn't full
+		constexpr size_t populationSize{3U * PersonPopulator::chunkSize + 17U};
+
+		// The age, behavior, home, workplace and school of every person as indices into the places
+		const auto createPopulation = [this](ThreadPool* pool)
+		{
+			Random::Engine stream{5U};
+			Random::StreamGuard streamGuard(stream);
+			PersonPopulator populationFactory(populationSize, PersonPopulator::GetCountryDistribution(country));
+			auto places = PlaceBuilder::CreatePlaces(populationSize, country);
+			auto population = populationFactory.CreatePopulation(country, places.homes, places.workplaces, places.schools, &community, pool);
+
+			std::vector<std::array<int64_t, 6>> people{};
+			for (auto& person : population)
+			{
+				const auto workplaceIndex = person.GetWorkplace() == nullptr ? -1 : person.GetWorkplace() - places.workplaces.data();
+				const auto schoolIndex = person.GetSchool() == nullptr ? -1 : person.GetSchool() - places.schools.data();
+				const auto& behavior = person.GetBehavior();
+				people.push_back({static_cast<int64_t>(person.GetAgeGroup()), behavior.foodBuyInterval, behavior.hardwareBuyInterval, person.GetHome() - places.homes.data(), workplaceIndex, schoolIndex});
+			}
+			return people;
+		};
+
+		ThreadPool onePool{1U};
+		const auto first = createPopulation(&onePool);
+		ASSERT_EQ(first.size(), populationSize);
+		ThreadPool fourPool{4U};
+		EXPECT_EQ(createPopulation(&fourPool), first);
+		EXPECT_EQ(createPopulation(nullptr), first);
+	}
 } // namespace UnitTests
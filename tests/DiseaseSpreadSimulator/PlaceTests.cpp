@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <type_traits>
 #include <vector>
 #include "Enums.h"
 #include "Places/Places.h"
+#include "Places/PlaceArena.h"
 #include "Person/Person.h"
 #include "Person/PersonBehavior.h"
 
@@ -29,6 +31,14 @@ namespace UnitTests
 		EXPECT_EQ(hardware.GetType(), DiseaseSpreadSimulation::Place_Type::HardwareStore);
 		EXPECT_EQ(morgue.GetType(), DiseaseSpreadSimulation::Place_Type::Morgue);
 		EXPECT_EQ(travel.GetType(), DiseaseSpreadSimulation::Place_Type::Travel);
+
+		// The type is stored, so places don't need a vtable
+		static_assert(!std::is_polymorphic_v<DiseaseSpreadSimulation::Home>);
+		static_assert(!std::is_polymorphic_v<DiseaseSpreadSimulation::Travel>);
+		// Assignment keeps the type of the place
+		DiseaseSpreadSimulation::Home otherHome;
+		home = std::move(otherHome);
+		EXPECT_EQ(home.GetType(), DiseaseSpreadSimulation::Place_Type::Home);
 	}
 	TEST_F(PlaceTests, AddPerson)
 	{
@@ -74,10 +84,10 @@ namespace UnitTests
 		home.RemovePerson(personID);
 		EXPECT_EQ(home.GetPersonCount(), 2);
 
-		// Check that the right persons are inside home
+		// Check that the right persons are inside home. Removing does not keep the order.
 		auto people = home.GetPeople();
 
-		ASSERT_TRUE(*people.front() == person1 && *people.back() == person2);
+		ASSERT_TRUE((*people.front() == person1 && *people.back() == person2) || (*people.front() == person2 && *people.back() == person1));
 
 		// Remove the rest
 		home.RemovePerson(personID1);
@@ -94,6 +104,54 @@ namespace UnitTests
 		home.RemovePerson(&person2);
 		ASSERT_EQ(home.GetPersonCount(), 0);
 	}
+	TEST_F(PlaceTests, RemovePersonAfterOthersLeft)
+	{
+		DiseaseSpreadSimulation::Person person(DiseaseSpreadSimulation::Age_Group::UnderTwenty, DiseaseSpreadSimulation::Sex::Male, behavior, nullptr);
+		DiseaseSpreadSimulation::Person person1(DiseaseSpreadSimulation::Age_Group::UnderTwenty, DiseaseSpreadSimulation::Sex::Male, behavior, nullptr);
+		DiseaseSpreadSimulation::Person person2(DiseaseSpreadSimulation::Age_Group::UnderTwenty, DiseaseSpreadSimulation::Sex::Female, behavior, nullptr);
+
+		home.AddPerson(&person);
+		home.AddPerson(&person1);
+		home.AddPerson(&person2);
+
+		// The last person takes the place of the removed one and has to be found there
+		home.RemovePerson(&person);
+		home.RemovePerson(&person2);
+		ASSERT_EQ(home.GetPersonCount(), 1);
+		EXPECT_EQ(*home.GetPeople().front(), person1);
+
+		// A person that is not inside is ignored
+		home.RemovePerson(&person2);
+		EXPECT_EQ(home.GetPersonCount(), 1);
+		home.RemovePerson(&person1);
+		ASSERT_EQ(home.GetPersonCount(), 0);
+	}
+	TEST_F(PlaceTests, PeopleInsideArena)
+	{
+		DiseaseSpreadSimulation::Person person(DiseaseSpreadSimulation::Age_Group::UnderTwenty, DiseaseSpreadSimulation::Sex::Male, behavior, nullptr);
+		DiseaseSpreadSimulation::Person person1(DiseaseSpreadSimulation::Age_Group::UnderTwenty, DiseaseSpreadSimulation::Sex::Female, behavior, nullptr);
+		DiseaseSpreadSimulation::PlaceArena arena{1024U};
+
+		DiseaseSpreadSimulation::Home arenaHome{&arena};
+		arenaHome.Reserve(4U);
+		EXPECT_EQ(arenaHome.GetPeople().get_allocator().resource(), &arena);
+		EXPECT_GE(arenaHome.GetPeople().capacity(), 4U);
+		arenaHome.AddPerson(&person);
+		arenaHome.AddPerson(&person1);
+
+		// Copies don't depend on the arena
+		DiseaseSpreadSimulation::Home copy{arenaHome};
+		EXPECT_EQ(copy.GetPeople().get_allocator().resource(), std::pmr::get_default_resource());
+		ASSERT_EQ(copy.GetPersonCount(), 2U);
+
+		// Places of different resources keep their own and exchange only the people
+		home.AddPerson(&person);
+		home = std::move(arenaHome);
+		EXPECT_EQ(home.GetPeople().get_allocator().resource(), std::pmr::get_default_resource());
+		ASSERT_EQ(home.GetPersonCount(), 2U);
+		EXPECT_EQ(home.GetPeople().back(), &person1);
+		EXPECT_EQ(arenaHome.GetPersonCount(), 1U); // NOLINT(bugprone-use-after-move)
+	}
 	TEST_F(PlaceTests, TypeToString)
 	{
 		using namespace DiseaseSpreadSimulation;
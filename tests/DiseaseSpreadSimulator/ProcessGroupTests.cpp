@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Simulation/ProcessGroup.h"
+
+namespace UnitTests
+{
+	TEST(ProcessGroupTests, EveryRankGetsItsMessages)
+	{
+		constexpr uint32_t processCount{3U};
+		auto processGroups = DiseaseSpreadSimulation::ProcessGroup::Connect(processCount);
+		std::vector<std::vector<DiseaseSpreadSimulation::ProcessGroup::Message>> received(processCount);
+		std::vector<std::exception_ptr> errors(processCount);
+		std::vector<std::thread> ranks{};
+		for (uint32_t rank = 0U; rank < processCount; rank++)
+		{
+			ranks.emplace_back([&processGroups, &received, &errors, rank]()
+				{
+					try
+					{
+						// Large enough to fill the sockets, so every rank has to send and receive at the same time
+						std::vector<DiseaseSpreadSimulation::ProcessGroup::Message> messages(processCount);
+						for (uint32_t peer = 0U; peer < processCount; peer++)
+						{
+							messages[peer].assign((rank + 1U) * 300000U + peer, static_cast<std::byte>(rank * 10U + peer));
+						}
+						received[rank] = processGroups[rank].Exchange(std::move(messages));
+					}
+					catch (...)
+					{
+						errors[rank] = std::current_exception();
+					}
+				});
+		}
+		for (auto& rank : ranks)
+		{
+			rank.join();
+		}
+
+		for (uint32_t rank = 0U; rank < processCount; rank++)
+		{
+			ASSERT_FALSE(errors[rank]);
+			EXPECT_EQ(processGroups[rank].Rank(), rank);
+			EXPECT_EQ(processGroups[rank].Size(), processCount);
+			ASSERT_EQ(received[rank].size(), processCount);
+			for (uint32_t peer = 0U; peer < processCount; peer++)
+			{
+				const auto& message = received[rank][peer];
+				ASSERT_EQ(message.size(), (peer + 1U) * 300000U + rank);
+				EXPECT_EQ(message.front(), static_cast<std::byte>(peer * 10U + rank));
+				EXPECT_EQ(message.back(), static_cast<std::byte>(peer * 10U + rank));
+			}
+		}
+	}
+	TEST(ProcessGroupTests, ValuesRoundTrip)
+	{
+		const std::vector<uint32_t> values{1U, 2U, 3U};
+		const auto message = DiseaseSpreadSimulation::ProcessGroup::ToMessage(values);
+		EXPECT_EQ(message.size(), sizeof(uint32_t) * values.size());
+		EXPECT_EQ(DiseaseSpreadSimulation::ProcessGroup::FromMessage<uint32_t>(message), values);
+		EXPECT_THROW(static_cast<void>(DiseaseSpreadSimulation::ProcessGroup::FromMessage<uint64_t>(message)), std::runtime_error);
+	}
+
+	// Forks the process into two ranks and exchanges a message there and back. The child leaves with the exit code.
+	// Returns 0 when the answer arrived and the child has succeeded, 1 for a wrong answer and 2 when closing reports the child.
+	int ExchangeWithForkedProcess(int childExitCode)
+	{
+		auto processGroup = DiseaseSpreadSimulation::ProcessGroup::Fork(2U);
+		std::vector<DiseaseSpreadSimulation::ProcessGroup::Message> messages(2U);
+		if (processGroup.Rank() == 1U)
+		{
+			// The child sends back what it got and leaves without running anything else
+			auto received = processGroup.Exchange(std::move(messages));
+			std::vector<DiseaseSpreadSimulation::ProcessGroup::Message> answer(2U);
+			answer[0] = received[0];
+			static_cast<void>(processGroup.Exchange(std::move(answer)));
+			processGroup.Close();
+			std::_Exit(childExitCode);
+		}
+
+		const std::vector<uint32_t> values{42U, 7U};
+		messages[1] = DiseaseSpreadSimulation::ProcessGroup::ToMessage(values);
+		static_cast<void>(processGroup.Exchange(std::move(messages)));
+		const auto answer = processGroup.Exchange(std::vector<DiseaseSpreadSimulation::ProcessGroup::Message>(2U));
+		if (DiseaseSpreadSimulation::ProcessGroup::FromMessage<uint32_t>(answer[1]) != values)
+		{
+			return 1;
+		}
+		try
+		{
+			processGroup.Close();
+		}
+		catch (const std::runtime_error&)
+		{
+			return 2;
+		}
+		return 0;
+	}
+
+	// Forking a process with running threads is not safe, so the ranks are forked from a fresh death test process,
+	// which only runs the thread of the test
+	TEST(ProcessGroupDeathTest, ForkedProcessAnswers)
+	{
+		GTEST_FLAG_SET(death_test_style, "threadsafe");
+		EXPECT_EXIT(std::_Exit(ExchangeWithForkedProcess(0)), ::testing::ExitedWithCode(0), "");
+	}
+	TEST(ProcessGroupDeathTest, ReportsFailedProcess)
+	{
+		GTEST_FLAG_SET(death_test_style, "threadsafe");
+		EXPECT_EXIT(std::_Exit(ExchangeWithForkedProcess(3)), ::testing::ExitedWithCode(2), "");
+	}
+} // namespace UnitTests
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Simulation/MeasureTime.h"
+
+namespace UnitTests
+{
+	class ProfilerTests : public ::testing::Test
+	{
+	protected:
+		using Clock = Measure::Profiler::Clock;
+		using Milliseconds = std::chrono::milliseconds;
+
+		std::string traceFilename{(std::filesystem::temp_directory_path() / "profilerTest.json").string()};
+
+		void SetUp() override
+		{
+			Measure::Profiler::Reset();
+		}
+		void TearDown() override
+		{
+			Measure::Profiler::Reset();
+			std::filesystem::remove(traceFilename);
+		}
+
+		static void Record(uint32_t zone, Milliseconds duration)
+		{
+			const auto begin = Clock::now();
+			Measure::Profiler::Record(zone, begin, begin + duration);
+		}
+		static std::optional<Measure::Profiler::ZoneSummary> FindZone(const std::string& name)
+		{
+			const auto summary = Measure::Profiler::Summary();
+			const auto zone = std::find_if(summary.begin(), summary.end(), [&name](const Measure::Profiler::ZoneSummary& zoneSummary)
+				{
+					return zoneSummary.name == name;
+				});
+			if (zone == summary.end())
+			{
+				return std::nullopt;
+			}
+			return *zone;
+		}
+	};
+
+	TEST_F(ProfilerTests, ZonesShareTheirName)
+	{
+		const auto zone = Measure::Profiler::RegisterZone("ProfilerTests.Shared");
+		EXPECT_EQ(Measure::Profiler::RegisterZone("ProfilerTests.Shared"), zone);
+		EXPECT_NE(Measure::Profiler::RegisterZone("ProfilerTests.Other"), zone);
+	}
+	TEST_F(ProfilerTests, AccumulatesCallsOfEveryThread)
+	{
+		const auto zone = Measure::Profiler::RegisterZone("ProfilerTests.Accumulate");
+		Record(zone, Milliseconds{3});
+		Record(zone, Milliseconds{1});
+		std::thread other([zone]()
+			{
+				Record(zone, Milliseconds{5});
+			});
+		other.join();
+
+		const auto summary = FindZone("ProfilerTests.Accumulate");
+		ASSERT_TRUE(summary.has_value());
+		EXPECT_EQ(summary->calls, 3U);
+		EXPECT_EQ(summary->total, Milliseconds{9});
+		EXPECT_EQ(summary->min, Milliseconds{1});
+		EXPECT_EQ(summary->max, Milliseconds{5});
+	}
+	TEST_F(ProfilerTests, SummarySortedByTotal)
+	{
+		const auto shortZone = Measure::Profiler::RegisterZone("ProfilerTests.Short");
+		const auto longZone = Measure::Profiler::RegisterZone("ProfilerTests.Long");
+		Record(shortZone, Milliseconds{1});
+		Record(longZone, Milliseconds{4});
+
+		const auto summary = Measure::Profiler::Summary();
+		ASSERT_EQ(summary.size(), 2U);
+		EXPECT_EQ(summary[0].name, "ProfilerTests.Long");
+		EXPECT_EQ(summary[1].name, "ProfilerTests.Short");
+	}
+	TEST_F(ProfilerTests, ResetDropsEveryCall)
+	{
+		const auto zone = Measure::Profiler::RegisterZone("ProfilerTests.Reset");
+		Record(zone, Milliseconds{2});
+		ASSERT_TRUE(FindZone("ProfilerTests.Reset").has_value());
+
+		Measure::Profiler::Reset();
+		EXPECT_TRUE(Measure::Profiler::Summary().empty());
+
+		// The zone stays registered and starts from zero
+		Record(zone, Milliseconds{7});
+		const auto summary = FindZone("ProfilerTests.Reset");
+		ASSERT_TRUE(summary.has_value());
+		EXPECT_EQ(summary->calls, 1U);
+		EXPECT_EQ(summary->min, Milliseconds{7});
+	}
+	TEST_F(ProfilerTests, PrintsEveryZone)
+	{
+		const auto zone = Measure::Profiler::RegisterZone("ProfilerTests.Print");
+		Record(zone, Milliseconds{2});
+		Record(zone, Milliseconds{2});
+
+		::testing::internal::CaptureStdout();
+		Measure::Profiler::PrintSummary();
+		const auto output = ::testing::internal::GetCapturedStdout();
+		EXPECT_NE(output.find("Zone"), std::string::npos);
+		// Two calls with a total of 4 ms
+		EXPECT_NE(output.find("ProfilerTests.Print"), std::string::npos);
+		EXPECT_NE(output.find("4.00"), std::string::npos);
+	}
+	TEST_F(ProfilerTests, WritesTraceEvents)
+	{
+		const auto zone = Measure::Profiler::RegisterZone("ProfilerTests.\"Trace\"");
+		Record(zone, Milliseconds{1});
+		Record(zone, Milliseconds{1});
+		Measure::Profiler::WriteChromeTrace(traceFilename);
+
+		std::ifstream file{traceFilename};
+		std::string trace{};
+		for (std::string line; std::getline(file, line);)
+		{
+			trace += line;
+		}
+		// The name is escaped
+		const std::string name{R"("name":"ProfilerTests.\"Trace\"")"};
+		const auto first = trace.find(name);
+		ASSERT_NE(first, std::string::npos);
+		EXPECT_NE(trace.find(name, first + 1U), std::string::npos);
+		EXPECT_NE(trace.find(R"("droppedEvents":0)"), std::string::npos);
+	}
+} // namespace UnitTests
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Simulation/Mobility.h"
+#include "Simulation/ProcessGroup.h"
+#include "Simulation/RunController.h"
+#include "Simulation/Simulation.h"
+#include "Simulation/ThreadPool.h"
+
+namespace UnitTests
+{
+	class RunControllerTests : public ::testing::Test
+	{
+	protected:
+		static constexpr uint64_t populationSize{200U};
+		static constexpr uint64_t seed{13U};
+		const std::string diseaseFilename{};
+		DiseaseSpreadSimulation::Simulation simulation{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+	};
+
+	TEST_F(RunControllerTests, StepsOnTheWorker)
+	{
+		DiseaseSpreadSimulation::RunController controller{simulation};
+		auto hours = controller.AdvanceHours(30U);
+		auto untilDay = controller.RunUntilDay(3U);
+		EXPECT_EQ(hours.get(), 30U);
+		EXPECT_EQ(untilDay.get(), 42U);
+		controller.Wait();
+		EXPECT_EQ(simulation.GetElapsedHours(), 72U);
+	}
+	TEST_F(RunControllerTests, RunsLikeTheCaller)
+	{
+		// Every hour of the run until nobody is exposed or infectious any more
+		const auto record = [](std::vector<size_t>& infected)
+		{
+			return [&infected](const DiseaseSpreadSimulation::PopulationCounts& counts)
+			{
+				infected.push_back(counts.everInfected);
+				return counts.exposed + counts.infectious == 0U;
+			};
+		};
+		constexpr uint64_t maxHours{24U * 30U};
+
+		std::vector<size_t> expected{};
+		DiseaseSpreadSimulation::Simulation direct{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+		const auto expectedIsMet = direct.RunUntil(record(expected), maxHours);
+
+		std::vector<size_t> infected{};
+		DiseaseSpreadSimulation::RunController controller{simulation};
+		EXPECT_EQ(controller.RunUntil(record(infected), maxHours).get(), expectedIsMet);
+		EXPECT_EQ(infected, expected);
+		EXPECT_GT(infected.size(), 1U);
+	}
+	TEST_F(RunControllerTests, PauseHoldsTheStep)
+	{
+		DiseaseSpreadSimulation::RunController controller{simulation};
+		controller.Pause();
+		auto hours = controller.AdvanceHours(5U);
+		EXPECT_EQ(hours.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+		controller.Resume();
+		EXPECT_EQ(hours.get(), 5U);
+	}
+	TEST_F(RunControllerTests, StopEndsAPausedRun)
+	{
+		DiseaseSpreadSimulation::RunController controller{simulation};
+		static_cast<void>(controller.AdvanceHours(1U).get());
+		auto run = controller.Run();
+		controller.Pause();
+		controller.Stop();
+		// Run was either started and ended or dropped before it started
+		try
+		{
+			run.get();
+		}
+		catch (const std::future_error& error)
+		{
+			EXPECT_EQ(error.code(), std::future_errc::broken_promise);
+		}
+		controller.Wait();
+
+		// Stopped for good
+		EXPECT_EQ(controller.AdvanceHours(5U).get(), 0U);
+		EXPECT_FALSE(controller.RunUntil([](const DiseaseSpreadSimulation::PopulationCounts&)
+									 {
+										 return false;
+									 })
+						 .get());
+	}
+	TEST_F(RunControllerTests, WaitReturnsWhilePaused)
+	{
+		DiseaseSpreadSimulation::RunController controller{simulation};
+		controller.Pause();
+		auto hours = controller.AdvanceHours(5U);
+		EXPECT_FALSE(controller.Wait());
+		controller.Resume();
+		EXPECT_EQ(hours.get(), 5U);
+		EXPECT_TRUE(controller.Wait());
+	}
+	TEST_F(RunControllerTests, ResetRunStateAfterStop)
+	{
+		DiseaseSpreadSimulation::RunController controller{simulation};
+		controller.Stop();
+		controller.Wait();
+		EXPECT_EQ(controller.AdvanceHours(5U).get(), 0U);
+
+		controller.ResetRunState();
+		EXPECT_EQ(controller.AdvanceHours(5U).get(), 5U);
+		EXPECT_EQ(simulation.GetElapsedHours(), 5U);
+	}
+	TEST_F(RunControllerTests, StoppedRunForDaysSimulatesNothing)
+	{
+		const auto elapsedHours = simulation.GetElapsedHours();
+		simulation.Stop();
+		simulation.RunForDays(2U);
+		simulation.CompareContainmentMeasures(2U, 2U);
+		static_cast<void>(simulation.RunScenario(2U, DiseaseSpreadSimulation::DiseaseContainmentMeasures::Nothing));
+		EXPECT_EQ(simulation.GetElapsedHours(), elapsedHours);
+
+		simulation.ResetRunState();
+		simulation.RunForDays(1U);
+		EXPECT_EQ(simulation.GetElapsedHours(), elapsedHours + 24U);
+	}
+	TEST_F(RunControllerTests, StopEndsAPausedRegion)
+	{
+		const auto mobility = DiseaseSpreadSimulation::MobilityMatrix::Ring(3U);
+		DiseaseSpreadSimulation::ThreadPool pool{2U};
+		simulation.SetMobility(&mobility, &pool);
+		simulation.Pause();
+		auto run = std::async(std::launch::async, [this]()
+			{
+				simulation.RunRegion(30U);
+			});
+		EXPECT_EQ(run.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+		simulation.Stop();
+		run.get();
+		EXPECT_EQ(simulation.GetElapsedHours(), 0U);
+	}
+#ifndef _WIN32
+	TEST_F(RunControllerTests, SplitRegionStopsTogether)
+	{
+		constexpr uint32_t processCount{2U};
+		const auto mobility = DiseaseSpreadSimulation::MobilityMatrix::Ring(4U);
+		auto processGroups = DiseaseSpreadSimulation::ProcessGroup::Connect(processCount);
+		std::vector<uint64_t> elapsedHours(processCount);
+		std::vector<std::thread> ranks{};
+		for (uint32_t rank = 0U; rank < processCount; rank++)
+		{
+			ranks.emplace_back([this, rank, &mobility, &processGroups, &elapsedHours]()
+				{
+					DiseaseSpreadSimulation::ThreadPool pool{1U};
+					DiseaseSpreadSimulation::Simulation region{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+					region.SetMobility(&mobility, &pool, &processGroups[rank]);
+					// Only the first rank is stopped, the other one has to end with it
+					if (rank == 0U)
+					{
+						region.Stop();
+					}
+					region.RunRegion(3U);
+					elapsedHours[rank] = region.GetElapsedHours();
+				});
+		}
+		for (auto& rank : ranks)
+		{
+			rank.join();
+		}
+		EXPECT_EQ(elapsedHours, std::vector<uint64_t>(processCount, 0U));
+	}
+#endif
+} // namespace UnitTests
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Simulation/Simulation.h"
+#include "Simulation/TimeSeries.h"
+
+namespace UnitTests
+{
+	class SnapshotTests : public ::testing::Test
+	{
+	protected:
+		static constexpr uint64_t populationSize{300U};
+		static constexpr uint64_t seed{13U};
+		const std::string diseaseFilename{};
+		std::string snapshotFilename{(std::filesystem::temp_directory_path() / "snapshotTest.bin").string()};
+		std::string csvFilename{(std::filesystem::temp_directory_path() / "snapshotTest.csv").string()};
+
+		void TearDown() override
+		{
+			std::filesystem::remove(snapshotFilename);
+			std::filesystem::remove(csvFilename);
+		}
+
+		// The counters after every hour
+		static std::vector<std::vector<size_t>> RecordHours(DiseaseSpreadSimulation::Simulation& simulation, uint64_t hours)
+		{
+			std::vector<std::vector<size_t>> records{};
+			static_cast<void>(simulation.RunUntil([&records](const DiseaseSpreadSimulation::PopulationCounts& counts)
+				{
+					records.push_back({counts.alive, counts.susceptible, counts.exposed, counts.infectious, counts.recovered, counts.withDisease, counts.traveling, counts.quarantined, counts.dead, counts.everInfected});
+					return false;
+				},
+				hours));
+			return records;
+		}
+	};
+
+	TEST_F(SnapshotTests, ContinuesLikeStraightRun)
+	{
+		constexpr uint64_t hoursBefore{24U * 3U};
+		constexpr uint64_t hoursAfter{24U * 5U};
+		DiseaseSpreadSimulation::Simulation straight{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+		ASSERT_EQ(straight.AdvanceHours(hoursBefore), hoursBefore);
+		const auto expected = RecordHours(straight, hoursAfter);
+
+		{
+			DiseaseSpreadSimulation::Simulation saved{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+			ASSERT_EQ(saved.AdvanceHours(hoursBefore), hoursBefore);
+			saved.SaveSnapshot(snapshotFilename);
+		}
+		// Another seed, which the snapshot replaces
+		DiseaseSpreadSimulation::Simulation loaded{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed + 1U};
+		loaded.LoadSnapshot(snapshotFilename);
+		EXPECT_EQ(loaded.GetElapsedHours(), straight.GetElapsedHours() - hoursAfter);
+		EXPECT_EQ(RecordHours(loaded, hoursAfter), expected);
+	}
+	TEST_F(SnapshotTests, LoadedRunKeepsRunNumber)
+	{
+		{
+			DiseaseSpreadSimulation::Simulation saved{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+			saved.RunForDays(1U);
+			saved.SaveSnapshot(snapshotFilename);
+		}
+		{
+			DiseaseSpreadSimulation::TimeSeriesSink sink{csvFilename, DiseaseSpreadSimulation::TimeSeriesSink::Format::Csv};
+			DiseaseSpreadSimulation::Simulation loaded{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+			loaded.SetTimeSeriesSink(&sink);
+			loaded.LoadSnapshot(snapshotFilename);
+			loaded.RunForDays(1U);
+			sink.Flush();
+		}
+
+		std::ifstream file{csvFilename};
+		std::string line{};
+		ASSERT_TRUE(std::getline(file, line));
+		// The first day after the header belongs to the first run
+		ASSERT_TRUE(std::getline(file, line));
+		EXPECT_EQ(line.substr(0, 2), "1,");
+	}
+	TEST_F(SnapshotTests, RejectsCorruptedSnapshot)
+	{
+		{
+			DiseaseSpreadSimulation::Simulation saved{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+			saved.RunForDays(1U);
+			saved.SaveSnapshot(snapshotFilename);
+		}
+		std::string bytes{};
+		{
+			std::ifstream file{snapshotFilename, std::ios::binary};
+			bytes.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+		}
+		// Magic, version, seed, country, population size, run number, elapsed days and elapsed hours come before the new day flag
+		constexpr size_t newDayOffset{4U + 4U + 8U + 4U + 8U + 4U + 8U + 8U};
+		// The time, which is followed by the number of diseases
+		constexpr size_t diseaseCountOffset{newDayOffset + 1U + 8U + 4U + 1U + 4U};
+		ASSERT_GT(bytes.size(), diseaseCountOffset + 4U);
+		const auto loadCorrupted = [this, &bytes](size_t offset, const std::string& corruption)
+		{
+			auto corrupted = bytes;
+			corrupted.replace(offset, corruption.size(), corruption);
+			{
+				std::ofstream file{snapshotFilename, std::ios::binary};
+				file.write(corrupted.data(), static_cast<std::streamsize>(corrupted.size()));
+			}
+			DiseaseSpreadSimulation::Simulation loaded{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, seed};
+			loaded.LoadSnapshot(snapshotFilename);
+		};
+
+		// A bool that is neither true nor false
+		EXPECT_THROW(loadCorrupted(newDayOffset, std::string(1U, '\x07')), std::runtime_error);
+		// More diseases than the file could hold
+		EXPECT_THROW(loadCorrupted(diseaseCountOffset, std::string(4U, '\xFF')), std::runtime_error);
+		// An unknown country
+		EXPECT_THROW(loadCorrupted(16U, std::string(4U, '\x7F')), std::runtime_error);
+		// The untouched snapshot still loads
+		EXPECT_NO_THROW(loadCorrupted(0U, bytes.substr(0U, 4U)));
+	}
+} // namespace UnitTests
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Simulation/Simulation.h"
+#include "Simulation/TaskGraph.h"
+#include "Simulation/ThreadPool.h"
+
+namespace UnitTests
+{
+	TEST(TaskGraphTests, RunsTasksAfterTheirDependencies)
+	{
+		DiseaseSpreadSimulation::ThreadPool pool{4U};
+		DiseaseSpreadSimulation::TaskGraph graph{};
+		std::atomic<uint32_t> order{0U};
+		std::vector<uint32_t> finished(7U, 0U);
+		const auto task = [&order, &finished](size_t index)
+		{
+			return [&order, &finished, index]()
+			{
+				finished[index] = ++order;
+			};
+		};
+
+		// Two chains joined by the last task
+		const auto first = graph.Add(task(0U));
+		const auto second = graph.Add(task(1U), {first});
+		const auto third = graph.Add(task(2U), {first});
+		const auto other = graph.Add(task(3U));
+		const auto otherNext = graph.Add(task(4U), {other});
+		graph.Add(task(5U), {second, third, otherNext});
+		graph.Add(task(6U));
+		EXPECT_EQ(graph.TaskCount(), 7U);
+		EXPECT_THROW(graph.Add(task(0U), {9U}), std::out_of_range);
+
+		for (auto run = 0; run < 3; run++)
+		{
+			order = 0U;
+			graph.Run(pool);
+			EXPECT_EQ(order, 7U);
+			EXPECT_LT(finished[0], finished[1]);
+			EXPECT_LT(finished[0], finished[2]);
+			EXPECT_LT(finished[3], finished[4]);
+			EXPECT_GT(finished[5], finished[1]);
+			EXPECT_GT(finished[5], finished[2]);
+			EXPECT_GT(finished[5], finished[4]);
+		}
+	}
+	TEST(TaskGraphTests, SkipsDependentsOfFailedTasks)
+	{
+		DiseaseSpreadSimulation::ThreadPool pool{2U};
+		DiseaseSpreadSimulation::TaskGraph graph{};
+		bool ranDependent{false};
+		const auto failing = graph.Add([]()
+			{
+				throw std::runtime_error("Failed");
+			});
+		graph.Add([&ranDependent]()
+			{
+				ranDependent = true;
+			},
+			{failing});
+		EXPECT_THROW(graph.Run(pool), std::runtime_error);
+		EXPECT_FALSE(ranDependent);
+	}
+	TEST(TaskGraphTests, CommunitiesDoNotDependOnThreadCount)
+	{
+		const std::string diseaseFilename{};
+		// Infected persons of every hour for ten days
+		const auto run = [&diseaseFilename](DiseaseSpreadSimulation::ThreadPool* pool)
+		{
+			DiseaseSpreadSimulation::Simulation simulation{500U, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, 21U};
+			simulation.SetThreadPool(pool);
+			std::vector<size_t> infected{};
+			static_cast<void>(simulation.RunUntil([&infected](const DiseaseSpreadSimulation::PopulationCounts& counts)
+				{
+					infected.push_back(counts.everInfected);
+					return false;
+				},
+				24U * 10U));
+			return infected;
+		};
+
+		const auto infected = run(nullptr);
+		DiseaseSpreadSimulation::ThreadPool onePool{1U};
+		EXPECT_EQ(run(&onePool), infected);
+		DiseaseSpreadSimulation::ThreadPool fourPool{4U};
+		EXPECT_EQ(run(&fourPool), infected);
+	}
+} // namespace UnitTests
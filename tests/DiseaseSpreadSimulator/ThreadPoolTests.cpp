@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "Simulation/ThreadPool.h"
+#include "Simulation/Ensemble.h"
+
+namespace UnitTests
+{
+	TEST(ThreadPoolTests, RunsEveryTask)
+	{
+		DiseaseSpreadSimulation::ThreadPool pool{4U};
+		EXPECT_EQ(pool.ThreadCount(), 4U);
+
+		constexpr size_t taskCount{1000U};
+		std::vector<int> done(taskCount, 0);
+		for (size_t i = 0; i < taskCount; i++)
+		{
+			pool.Submit([&done, i]()
+				{
+					done[i]++;
+				});
+		}
+		pool.Wait();
+
+		for (const auto value : done)
+		{
+			EXPECT_EQ(value, 1);
+		}
+	}
+	TEST(ThreadPoolTests, TasksSubmitTasks)
+	{
+		DiseaseSpreadSimulation::ThreadPool pool{3U};
+		std::atomic<int> count{0};
+
+		for (auto i = 0; i < 10; i++)
+		{
+			pool.Submit([&pool, &count]()
+				{
+					for (auto j = 0; j < 10; j++)
+					{
+						pool.Submit([&count]()
+							{
+								++count;
+							});
+					}
+					// Waiting inside a task runs the other tasks meanwhile
+					pool.Wait();
+					++count;
+				});
+		}
+		pool.Wait();
+
+		EXPECT_EQ(count, 110);
+	}
+	TEST(ThreadPoolTests, RethrowsException)
+	{
+		DiseaseSpreadSimulation::ThreadPool pool{2U};
+		pool.Submit([]()
+			{
+				throw std::runtime_error("Task failed");
+			});
+		EXPECT_THROW(pool.Wait(), std::runtime_error);
+
+		// The pool can still be used
+		std::atomic<int> count{0};
+		pool.Submit([&count]()
+			{
+				++count;
+			});
+		EXPECT_NO_THROW(pool.Wait());
+		EXPECT_EQ(count, 1);
+	}
+	TEST(EnsembleTests, EstimateMean)
+	{
+		const auto single = DiseaseSpreadSimulation::Ensemble::EstimateMean({4.});
+		EXPECT_DOUBLE_EQ(single.mean, 4.);
+		EXPECT_DOUBLE_EQ(single.halfWidth, 0.);
+
+		// Standard error of 1 with 3 degrees of freedom
+		const auto estimate = DiseaseSpreadSimulation::Ensemble::EstimateMean({1., 3., 5., 7.});
+		EXPECT_DOUBLE_EQ(estimate.mean, 4.);
+		EXPECT_NEAR(estimate.halfWidth, 3.182 * std::sqrt(20. / 3. / 4.), 1e-9);
+	}
+	TEST(EnsembleTests, ResultDoesNotDependOnThreadCount)
+	{
+		const DiseaseSpreadSimulation::Ensemble ensemble{200U, "", DiseaseSpreadSimulation::Country::USA, 3U};
+
+		DiseaseSpreadSimulation::ThreadPool onePool{1U};
+		const auto one = ensemble.Run(5U, 2U, onePool);
+		DiseaseSpreadSimulation::ThreadPool fourPool{4U};
+		const auto four = ensemble.Run(5U, 2U, fourPool);
+
+		ASSERT_EQ(one.size(), DiseaseSpreadSimulation::Ensemble::containmentMeasures.size());
+		ASSERT_EQ(one.size(), four.size());
+		for (size_t i = 0; i < one.size(); i++)
+		{
+			EXPECT_EQ(one[i].replicas, 2U);
+			EXPECT_DOUBLE_EQ(one[i].everInfected.mean, four[i].everInfected.mean);
+			EXPECT_DOUBLE_EQ(one[i].everInfected.halfWidth, four[i].everInfected.halfWidth);
+			EXPECT_DOUBLE_EQ(one[i].positiveTests.mean, four[i].positiveTests.mean);
+		}
+	}
+} // namespace UnitTests
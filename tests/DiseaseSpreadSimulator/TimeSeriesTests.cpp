@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Simulation/TimeSeries.h"
+#include "Simulation/Simulation.h"
+
+namespace UnitTests
+{
+	class TimeSeriesTests : public ::testing::Test
+	{
+	protected:
+		std::string csvFilename{(std::filesystem::temp_directory_path() / "timeSeriesTest.csv").string()};
+		std::string columnarFilename{(std::filesystem::temp_directory_path() / "timeSeriesTest.bin").string()};
+
+		void TearDown() override
+		{
+			std::filesystem::remove(csvFilename);
+			std::filesystem::remove(columnarFilename);
+		}
+
+		static std::vector<std::string> ReadLines(const std::string& filename)
+		{
+			std::ifstream file{filename};
+			std::vector<std::string> lines{};
+			for (std::string line; std::getline(file, line);)
+			{
+				lines.push_back(line);
+			}
+			return lines;
+		}
+	};
+
+	TEST_F(TimeSeriesTests, FormatFromFilename)
+	{
+		using Format = DiseaseSpreadSimulation::TimeSeriesSink::Format;
+		EXPECT_EQ(DiseaseSpreadSimulation::TimeSeriesSink::FormatFromFilename("counts.csv"), Format::Csv);
+		EXPECT_EQ(DiseaseSpreadSimulation::TimeSeriesSink::FormatFromFilename("counts.bin"), Format::Columnar);
+		EXPECT_EQ(DiseaseSpreadSimulation::TimeSeriesSink::FormatFromFilename("csv"), Format::Columnar);
+	}
+	TEST_F(TimeSeriesTests, WritesCsv)
+	{
+		{
+			DiseaseSpreadSimulation::TimeSeriesSink sink{csvFilename, DiseaseSpreadSimulation::TimeSeriesSink::Format::Csv};
+			sink.Append({{1U, 1U, 0U, 90U, 5U, 3U, 2U, 0U, 1U, 0U, 0U, 0U}});
+			sink.Append({{1U, 2U, 0U, 80U, 10U, 6U, 3U, 1U, 0U, 2U, 4U, 2U}, {1U, 2U, 1U, 50U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U}});
+		}
+
+		const auto lines = ReadLines(csvFilename);
+		ASSERT_EQ(lines.size(), 4U);
+		EXPECT_EQ(lines[0], "run,day,community,susceptible,exposed,infectious,recovered,dead,traveling,quarantined,positive_tests,persons_quarantined");
+		EXPECT_EQ(lines[1], "1,1,0,90,5,3,2,0,1,0,0,0");
+		EXPECT_EQ(lines[2], "1,2,0,80,10,6,3,1,0,2,4,2");
+		EXPECT_EQ(lines[3], "1,2,1,50,0,0,0,0,0,0,0,0");
+	}
+	TEST_F(TimeSeriesTests, FlushWritesToTheFile)
+	{
+		DiseaseSpreadSimulation::TimeSeriesSink sink{csvFilename, DiseaseSpreadSimulation::TimeSeriesSink::Format::Csv};
+		sink.Append({{1U, 1U, 0U, 90U, 5U, 3U, 2U, 0U, 1U, 0U, 0U, 0U}});
+		sink.Flush();
+		// Readable while the sink is still open
+		EXPECT_EQ(ReadLines(csvFilename).size(), 2U);
+
+		sink.Append({{1U, 2U, 0U, 80U, 10U, 6U, 3U, 1U, 0U, 2U, 4U, 2U}});
+		sink.Close();
+		EXPECT_EQ(ReadLines(csvFilename).size(), 3U);
+	}
+#ifndef _WIN32
+	TEST_F(TimeSeriesTests, FullDiskThrows)
+	{
+		if (!std::filesystem::exists("/dev/full"))
+		{
+			GTEST_SKIP();
+		}
+		EXPECT_THROW(DiseaseSpreadSimulation::TimeSeriesSink("/dev/full", DiseaseSpreadSimulation::TimeSeriesSink::Format::Csv), std::runtime_error);
+	}
+#endif
+	TEST_F(TimeSeriesTests, WritesColumnarBlocks)
+	{
+		constexpr auto columnCount = DiseaseSpreadSimulation::TimeSeriesSink::columns.size();
+		{
+			DiseaseSpreadSimulation::TimeSeriesSink sink{columnarFilename, DiseaseSpreadSimulation::TimeSeriesSink::Format::Columnar};
+			sink.Append({{1U, 1U, 0U, 90U, 5U, 3U, 2U, 0U, 1U, 0U, 0U, 0U}, {1U, 1U, 1U, 50U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U}});
+			sink.Flush();
+		}
+
+		std::ifstream file{columnarFilename, std::ios::binary};
+		// Little endian on every host
+		const auto read = [&file]()
+		{
+			std::array<char, sizeof(uint32_t)> bytes{};
+			file.read(bytes.data(), bytes.size());
+			uint32_t value{0U};
+			for (uint32_t byte = 0U; byte < bytes.size(); byte++)
+			{
+				value |= static_cast<uint32_t>(static_cast<unsigned char>(bytes.at(byte))) << (byte * 8U);
+			}
+			return value;
+		};
+		EXPECT_EQ(read(), DiseaseSpreadSimulation::TimeSeriesSink::magic);
+		EXPECT_EQ(read(), DiseaseSpreadSimulation::TimeSeriesSink::version);
+		ASSERT_EQ(read(), columnCount);
+		for (const auto& column : DiseaseSpreadSimulation::TimeSeriesSink::columns)
+		{
+			std::string name(read(), '\0');
+			file.read(name.data(), static_cast<std::streamsize>(name.size()));
+			EXPECT_EQ(name, column.first);
+		}
+
+		// One block with both rows, stored column after column
+		ASSERT_EQ(read(), 2U);
+		std::vector<uint32_t> values(2U * columnCount);
+		for (auto& value : values)
+		{
+			value = read();
+		}
+		EXPECT_EQ(values[4], 0U);
+		EXPECT_EQ(values[5], 1U);
+		EXPECT_EQ(values[6], 90U);
+		EXPECT_EQ(values[7], 50U);
+		EXPECT_TRUE(file);
+		read();
+		EXPECT_TRUE(file.eof());
+	}
+	TEST_F(TimeSeriesTests, SimulationAppendsEveryDay)
+	{
+		constexpr uint32_t days{3U};
+		constexpr uint64_t populationSize{200U};
+		const std::string diseaseFilename{};
+		{
+			DiseaseSpreadSimulation::TimeSeriesSink sink{csvFilename, DiseaseSpreadSimulation::TimeSeriesSink::Format::Csv};
+			DiseaseSpreadSimulation::Simulation simulation{populationSize, false, diseaseFilename, DiseaseSpreadSimulation::Country::USA, 5U};
+			simulation.SetTimeSeriesSink(&sink);
+			static_cast<void>(simulation.RunScenario(days, DiseaseSpreadSimulation::DiseaseContainmentMeasures::Nothing));
+			sink.Flush();
+		}
+
+		const auto lines = ReadLines(csvFilename);
+		// The header and one line per day of the single community
+		ASSERT_EQ(lines.size(), days + 1U);
+		EXPECT_EQ(lines[1].substr(0, 4), "0,1,");
+		EXPECT_EQ(lines[days].substr(0, 4), "0,3,");
+	}
+} // namespace UnitTests
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <array>
 #include <vector>
 #include <stdexcept>
 #include "IDGenerator/IDGenerator.h"
@@ -109,4 +110,90 @@ namespace UnitTests
 			EXPECT_FLOAT_EQ(Random::MapRangeToPercent(static_cast<float>(i), static_cast<float>(min), static_cast<float>(max)), static_cast<float>(i) * 0.1F);
 		}
 	}
+	TEST(RandomNumbersTests, SameSeedSameNumbers)
+	{
+		constexpr uint64_t seed{42U};
+		Random::SetSeed(seed);
+		std::vector<uint32_t> first{};
+		for (size_t i = 0; i < testSize; i++)
+		{
+			first.push_back(Random::UniformIntRange(0U, 1000U));
+		}
+
+		Random::SetSeed(seed);
+		for (size_t i = 0; i < testSize; i++)
+		{
+			EXPECT_EQ(Random::UniformIntRange(0U, 1000U), first.at(i));
+		}
+	}
+	TEST(RandomNumbersTests, IndependentStreams)
+	{
+		Random::Engine stream1{Random::StreamSeed(1U, 0U)};
+		Random::Engine stream2{Random::StreamSeed(1U, 1U)};
+		EXPECT_NE(stream1(), stream2());
+
+		// Copies continue with the same numbers
+		auto copy = stream1;
+		EXPECT_EQ(copy(), stream1());
+	}
+	TEST(RandomNumbersTests, LaneUnitDouble)
+	{
+		// Both ends of the range and the lowest bit of the 53 bits
+		static constexpr std::array<uint64_t, 4> edges{0U, 1ULL << 11U, 1ULL << 12U, ~0ULL};
+		for (const auto bits : edges)
+		{
+			EXPECT_EQ(Random::LaneUnitDouble(bits), Random::UnitDouble(bits));
+		}
+		Random::Engine stream{3U};
+		for (auto i = 0U; i < 1000U; i++)
+		{
+			const auto bits = stream();
+			EXPECT_EQ(Random::LaneUnitDouble(bits), Random::UnitDouble(bits));
+		}
+	}
+	TEST(RandomNumbersTests, StreamGuard)
+	{
+		Random::Engine stream{7U};
+		auto expected = stream;
+		expected();
+		{
+			Random::StreamGuard guard(stream);
+			EXPECT_EQ(&Random::Generator(), &stream);
+			{
+				Random::Engine inner{8U};
+				Random::StreamGuard innerGuard(inner);
+				EXPECT_EQ(&Random::Generator(), &inner);
+			}
+			EXPECT_EQ(&Random::Generator(), &stream);
+			Random::Generator()();
+		}
+		EXPECT_NE(&Random::Generator(), &stream);
+		EXPECT_EQ(stream, expected);
+	}
+	TEST(RandomNumbersTests, AliasTableFollowsWeights)
+	{
+		const std::array<float, 5> weights{1.F, 0.F, 2.F, 3.F, 4.F};
+		const Random::AliasTable table{weights};
+		ASSERT_EQ(table.Size(), weights.size());
+
+		constexpr size_t draws{100000U};
+		Random::Engine stream{Random::StreamSeed(5U, 0U)};
+		std::array<size_t, 5> counts{};
+		for (size_t i = 0; i < draws; i++)
+		{
+			counts.at(table(stream))++;
+		}
+		// A weight of 0 is never picked
+		EXPECT_EQ(counts.at(1), 0U);
+		for (size_t i = 0; i < weights.size(); i++)
+		{
+			EXPECT_NEAR(static_cast<float>(counts.at(i)) / static_cast<float>(draws), weights.at(i) / 10.F, 0.01F);
+		}
+	}
+	TEST(RandomNumbersTests, AliasTableNeedsPositiveWeight)
+	{
+		EXPECT_THROW(Random::AliasTable{std::vector<float>{}}, std::invalid_argument);
+		EXPECT_THROW((Random::AliasTable{std::array<float, 2>{0.F, 0.F}}), std::invalid_argument);
+		EXPECT_THROW((Random::AliasTable{std::array<float, 2>{1.F, -1.F}}), std::invalid_argument);
+	}
 } // namespace UnitTests